@@ -0,0 +1,340 @@
+// BettingRoundSubsystem.cpp
+
+#include "BettingRoundSubsystem.h"
+#include "RandomGameComponent.h"
+#include "SportsBettingComponent.h"
+#include "Algo/StableSort.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+
+void FBettingRoundTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Target)
+    {
+        Target->ResolvePendingWagers();
+    }
+}
+
+FString FBettingRoundTickFunction::DiagnosticMessage()
+{
+    return TEXT("UBettingRoundSubsystem::ResolvePendingWagers");
+}
+
+FName FBettingRoundTickFunction::DiagnosticContext(bool bDetailed)
+{
+    return FName(TEXT("BettingRoundSubsystem"));
+}
+
+bool UBettingRoundSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UBettingRoundSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    ResolveTickFunction.Target = this;
+    ResolveTickFunction.TickGroup = TG_PostUpdateWork;
+    ResolveTickFunction.bCanEverTick = true;
+    ResolveTickFunction.bStartWithTickEnabled = true;
+    ResolveTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UBettingRoundSubsystem::Deinitialize()
+{
+    if (ResolveTickFunction.IsTickFunctionRegistered())
+    {
+        ResolveTickFunction.UnRegisterTickFunction();
+    }
+    ResolveTickFunction.Target = nullptr;
+
+    PendingWagers.Empty();
+    ResolvingWagers.Empty();
+    ResolvedResults.Empty();
+
+    Super::Deinitialize();
+}
+
+int32 UBettingRoundSubsystem::QueueWager(FPendingWager&& Wager)
+{
+    Wager.TicketId = NextTicketId++;
+    const int32 TicketId = Wager.TicketId;
+
+    PendingWagers.Add(MoveTemp(Wager));
+    return TicketId;
+}
+
+int32 UBettingRoundSubsystem::QueueRandomRound(URandomGameComponent* Game, float Stake)
+{
+    if (!Game)
+    {
+        return INDEX_NONE;
+    }
+
+    FPendingWager Wager;
+    Wager.Kind = EWagerKind::RandomRound;
+    Wager.Component = Game;
+    Wager.Stake = Stake;
+    return QueueWager(MoveTemp(Wager));
+}
+
+int32 UBettingRoundSubsystem::QueueSportsBet(USportsBettingComponent* Sports, FName EventId, FName ChosenOutcomeId, float Stake)
+{
+    if (!Sports)
+    {
+        return INDEX_NONE;
+    }
+
+    FPendingWager Wager;
+    Wager.Kind = EWagerKind::SportsBet;
+    Wager.Component = Sports;
+    Wager.EventId = EventId;
+    Wager.ChosenOutcomeId = ChosenOutcomeId;
+    Wager.Stake = Stake;
+    return QueueWager(MoveTemp(Wager));
+}
+
+int32 UBettingRoundSubsystem::QueueTerritoryBet(UColorTerritoryBettingComponent* Territory, EBetColor Color, float Stake)
+{
+    if (!Territory)
+    {
+        return INDEX_NONE;
+    }
+
+    FPendingWager Wager;
+    Wager.Kind = EWagerKind::TerritoryBet;
+    Wager.Component = Territory;
+    Wager.Color = Color;
+    Wager.Stake = Stake;
+    return QueueWager(MoveTemp(Wager));
+}
+
+int32 UBettingRoundSubsystem::GetNumPendingWagers() const
+{
+    return PendingWagers.Num();
+}
+
+void UBettingRoundSubsystem::ResolvePendingWagers()
+{
+    if (PendingWagers.Num() == 0)
+    {
+        return;
+    }
+
+    // Wagers queued from OnWagersResolved handlers go into the next batch.
+    Swap(PendingWagers, ResolvingWagers);
+    PendingWagers.Reset();
+
+    const int32 NumWagers = ResolvingWagers.Num();
+
+    ResolvedResults.Reset();
+    ResolvedResults.SetNum(NumWagers);
+
+    TArray<int32, TInlineAllocator<64>> Order;
+    Order.SetNumUninitialized(NumWagers);
+
+    for (int32 i = 0; i < NumWagers; ++i)
+    {
+        const FPendingWager& Wager = ResolvingWagers[i];
+        FWagerResult& Result = ResolvedResults[i];
+
+        Result.TicketId = Wager.TicketId;
+        Result.Kind = Wager.Kind;
+        Result.Component = Wager.Component.Get();
+        Result.Stake = Wager.Stake;
+
+        Order[i] = i;
+    }
+
+    // Group by kind, then component, then sports event, keeping queue order inside a group.
+    Algo::StableSort(Order, [this](int32 A, int32 B)
+    {
+        const FPendingWager& WagerA = ResolvingWagers[A];
+        const FPendingWager& WagerB = ResolvingWagers[B];
+
+        if (WagerA.Kind != WagerB.Kind)
+        {
+            return WagerA.Kind < WagerB.Kind;
+        }
+        if (WagerA.Component != WagerB.Component)
+        {
+            return WagerA.Component.Get() < WagerB.Component.Get();
+        }
+        return WagerA.EventId.CompareIndexes(WagerB.EventId) < 0;
+    });
+
+    int32 GroupStart = 0;
+    while (GroupStart < NumWagers)
+    {
+        const FPendingWager& First = ResolvingWagers[Order[GroupStart]];
+
+        int32 GroupEnd = GroupStart + 1;
+        while (GroupEnd < NumWagers)
+        {
+            const FPendingWager& Next = ResolvingWagers[Order[GroupEnd]];
+            if (Next.Kind != First.Kind || Next.Component != First.Component || Next.EventId != First.EventId)
+            {
+                break;
+            }
+            GroupEnd++;
+        }
+
+        const TConstArrayView<int32> Group = MakeArrayView(Order.GetData() + GroupStart, GroupEnd - GroupStart);
+
+        switch (First.Kind)
+        {
+        case EWagerKind::RandomRound:
+            ResolveRandomGroup(Group);
+            break;
+        case EWagerKind::SportsBet:
+            ResolveSportsGroup(Group);
+            break;
+        case EWagerKind::TerritoryBet:
+            ResolveTerritoryGroup(Group);
+            break;
+        }
+
+        GroupStart = GroupEnd;
+    }
+
+    ResolvingWagers.Reset();
+
+    OnWagersResolved.Broadcast(ResolvedResults);
+}
+
+void UBettingRoundSubsystem::ResolveRandomGroup(TConstArrayView<int32> Group)
+{
+    URandomGameComponent* Game = Cast<URandomGameComponent>(ResolvingWagers[Group[0]].Component.Get());
+    if (!Game)
+    {
+        return;
+    }
+
+    const int32 Num = Group.Num();
+
+    TArray<float, TInlineAllocator<32>> Stakes;
+    TArray<int32, TInlineAllocator<32>> OutcomeIndices;
+    TArray<float, TInlineAllocator<32>> NetWins;
+    Stakes.SetNumUninitialized(Num);
+    OutcomeIndices.SetNumUninitialized(Num);
+    NetWins.SetNumUninitialized(Num);
+
+    for (int32 k = 0; k < Num; ++k)
+    {
+        Stakes[k] = ResolvingWagers[Group[k]].Stake;
+    }
+
+    Game->PlayRoundsBatch(Stakes, OutcomeIndices, NetWins);
+
+    for (int32 k = 0; k < Num; ++k)
+    {
+        FWagerResult& Result = ResolvedResults[Group[k]];
+        Result.Stake = Stakes[k] > 0.0f ? Stakes[k] : Game->DefaultStake;
+
+        if (OutcomeIndices[k] == INDEX_NONE)
+        {
+            continue;
+        }
+
+        Result.bResolved = true;
+        Result.NetWin = NetWins[k];
+        Result.bPlayerWon = NetWins[k] > 0.0f;
+        Result.OutcomeIndex = OutcomeIndices[k];
+        Result.OutcomeId = Game->Outcomes[OutcomeIndices[k]].OutcomeId;
+    }
+}
+
+void UBettingRoundSubsystem::ResolveSportsGroup(TConstArrayView<int32> Group)
+{
+    USportsBettingComponent* Sports = Cast<USportsBettingComponent>(ResolvingWagers[Group[0]].Component.Get());
+    if (!Sports)
+    {
+        return;
+    }
+
+    const int32 Num = Group.Num();
+
+    TArray<FName, TInlineAllocator<32>> ChosenOutcomeIds;
+    TArray<float, TInlineAllocator<32>> Stakes;
+    TArray<FName, TInlineAllocator<32>> WinningOutcomeIds;
+    TArray<bool, TInlineAllocator<32>> PlayerWon;
+    TArray<float, TInlineAllocator<32>> NetWins;
+    ChosenOutcomeIds.SetNumUninitialized(Num);
+    Stakes.SetNumUninitialized(Num);
+    WinningOutcomeIds.SetNum(Num);
+    PlayerWon.SetNumUninitialized(Num);
+    NetWins.SetNumUninitialized(Num);
+
+    for (int32 k = 0; k < Num; ++k)
+    {
+        const FPendingWager& Wager = ResolvingWagers[Group[k]];
+        ChosenOutcomeIds[k] = Wager.ChosenOutcomeId;
+        Stakes[k] = Wager.Stake;
+    }
+
+    Sports->SettleBetsBatch(ResolvingWagers[Group[0]].EventId, ChosenOutcomeIds, Stakes, WinningOutcomeIds, PlayerWon, NetWins);
+
+    for (int32 k = 0; k < Num; ++k)
+    {
+        FWagerResult& Result = ResolvedResults[Group[k]];
+        Result.Stake = Stakes[k] > 0.0f ? Stakes[k] : Sports->DefaultStake;
+
+        if (WinningOutcomeIds[k].IsNone())
+        {
+            continue;
+        }
+
+        Result.bResolved = true;
+        Result.NetWin = NetWins[k];
+        Result.bPlayerWon = PlayerWon[k];
+        Result.OutcomeId = WinningOutcomeIds[k];
+    }
+}
+
+void UBettingRoundSubsystem::ResolveTerritoryGroup(TConstArrayView<int32> Group)
+{
+    UColorTerritoryBettingComponent* Territory = Cast<UColorTerritoryBettingComponent>(ResolvingWagers[Group[0]].Component.Get());
+    if (!Territory)
+    {
+        return;
+    }
+
+    const int32 Num = Group.Num();
+
+    TArray<EBetColor, TInlineAllocator<32>> Colors;
+    TArray<float, TInlineAllocator<32>> Stakes;
+    TArray<EBetColor, TInlineAllocator<32>> WinningColors;
+    TArray<bool, TInlineAllocator<32>> PlayerWon;
+    TArray<float, TInlineAllocator<32>> NetWins;
+    Colors.SetNumUninitialized(Num);
+    Stakes.SetNumUninitialized(Num);
+    WinningColors.SetNumUninitialized(Num);
+    PlayerWon.SetNumUninitialized(Num);
+    NetWins.SetNumUninitialized(Num);
+
+    for (int32 k = 0; k < Num; ++k)
+    {
+        const FPendingWager& Wager = ResolvingWagers[Group[k]];
+        Colors[k] = Wager.Color;
+        Stakes[k] = Wager.Stake;
+    }
+
+    const bool bSettled = Territory->SettleBetsBatch(Colors, Stakes, WinningColors, PlayerWon, NetWins);
+
+    for (int32 k = 0; k < Num; ++k)
+    {
+        FWagerResult& Result = ResolvedResults[Group[k]];
+        Result.Stake = Stakes[k] > 0.0f ? Stakes[k] : Territory->DefaultStake;
+
+        if (!bSettled)
+        {
+            continue;
+        }
+
+        Result.bResolved = true;
+        Result.NetWin = NetWins[k];
+        Result.bPlayerWon = PlayerWon[k];
+        Result.WinningColor = WinningColors[k];
+    }
+}
@@ -1,11 +1,46 @@
 // ColorTerritoryBettingComponent.cpp
 
 #include "ColorTerritoryBettingComponent.h"
+#include "BettingNetQuantization.h"
 #include "Math/UnrealMathUtility.h"
+#include "GameFramework/Actor.h"
+#include "Net/UnrealNetwork.h"
+
+void FColorBetNetItem::PostReplicatedAdd(const FColorBetNetArray& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->ApplyReplicatedItem(*this);
+    }
+}
+
+void FColorBetNetItem::PostReplicatedChange(const FColorBetNetArray& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->ApplyReplicatedItem(*this);
+    }
+}
 
 UColorTerritoryBettingComponent::UColorTerritoryBettingComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
+
+    SetIsReplicatedByDefault(true);
+}
+
+void UColorTerritoryBettingComponent::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    ReplicatedColorInfo.OwnerComponent = this;
+}
+
+void UColorTerritoryBettingComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(UColorTerritoryBettingComponent, ReplicatedColorInfo);
 }
 
 void UColorTerritoryBettingComponent::BeginPlay()
@@ -13,6 +48,73 @@ void UColorTerritoryBettingComponent::BeginPlay()
     Super::BeginPlay();
 
     InitializeColorInfoIfNeeded();
+    SyncReplicatedColorInfo();
+}
+
+bool UColorTerritoryBettingComponent::HasBettingAuthority() const
+{
+    const AActor* Owner = GetOwner();
+    return Owner && Owner->HasAuthority();
+}
+
+bool UColorTerritoryBettingComponent::HasReceivedServerState() const
+{
+    return HasBettingAuthority() || bHasReceivedServerState;
+}
+
+void UColorTerritoryBettingComponent::SyncReplicatedColorInfo()
+{
+    if (!HasBettingAuthority() || !GetIsReplicated())
+    {
+        return;
+    }
+
+    for (TPair<EBetColor, FColorBetInfo>& Pair : ColorInfo)
+    {
+        FColorBetInfo& Info = Pair.Value;
+
+        const uint16 QuantizedShare = BettingNetQuantization::QuantizeShare(Info.Share);
+        const uint16 QuantizedOdds = BettingNetQuantization::QuantizeOdds(Info.DecimalOdds);
+
+        // Keep the server on the same grid the clients see, so settled odds match displayed odds.
+        Info.Share = BettingNetQuantization::DequantizeShare(QuantizedShare);
+        Info.DecimalOdds = BettingNetQuantization::DequantizeOdds(QuantizedOdds);
+
+        FColorBetNetItem* Item = ReplicatedColorInfo.Items.FindByPredicate(
+            [Color = Pair.Key](const FColorBetNetItem& Candidate) { return Candidate.Color == Color; });
+
+        if (!Item)
+        {
+            Item = &ReplicatedColorInfo.Items.AddDefaulted_GetRef();
+            Item->Color = Pair.Key;
+        }
+        else if (Item->BlockCount == Info.BlockCount
+            && Item->QuantizedShare == QuantizedShare
+            && Item->QuantizedOdds == QuantizedOdds)
+        {
+            continue;
+        }
+
+        Item->BlockCount = Info.BlockCount;
+        Item->QuantizedShare = QuantizedShare;
+        Item->QuantizedOdds = QuantizedOdds;
+
+        ReplicatedColorInfo.MarkItemDirty(*Item);
+    }
+}
+
+void UColorTerritoryBettingComponent::ApplyReplicatedItem(const FColorBetNetItem& Item)
+{
+    InitializeColorInfoIfNeeded();
+
+    FColorBetInfo& Info = ColorInfo.FindOrAdd(Item.Color);
+    Info.BlockCount = Item.BlockCount;
+    Info.Share = BettingNetQuantization::DequantizeShare(Item.QuantizedShare);
+    Info.DecimalOdds = BettingNetQuantization::DequantizeOdds(Item.QuantizedOdds);
+
+    bHasReceivedServerState = true;
+
+    OnBetInfoReplicated.Broadcast(Item.Color);
 }
 
 void UColorTerritoryBettingComponent::InitializeColorInfoIfNeeded()
@@ -28,6 +130,12 @@ void UColorTerritoryBettingComponent::InitializeColorInfoIfNeeded()
 
 void UColorTerritoryBettingComponent::InternalSetBlockCount(EBetColor Color, int32 BlockCount)
 {
+    // Clients never predict; their state only comes from the server.
+    if (!HasBettingAuthority())
+    {
+        return;
+    }
+
     InitializeColorInfoIfNeeded();
 
     FColorBetInfo* Info = ColorInfo.Find(Color);
@@ -59,6 +167,11 @@ void UColorTerritoryBettingComponent::SetBlockCountForColor(EBetColor Color, int
 
 void UColorTerritoryBettingComponent::RecalculateSharesAndOdds()
 {
+    if (!HasBettingAuthority())
+    {
+        return;
+    }
+
     InitializeColorInfoIfNeeded();
 
     int32 TotalBlocks = 0;
@@ -81,6 +194,7 @@ void UColorTerritoryBettingComponent::RecalculateSharesAndOdds()
             Pair.Value.Share = 0.0f;
             Pair.Value.DecimalOdds = 0.0f;
         }
+        SyncReplicatedColorInfo();
         return;
     }
 
@@ -108,10 +222,12 @@ void UColorTerritoryBettingComponent::RecalculateSharesAndOdds()
         Info.Share = static_cast<float>(Clamped) / TotalBlocksFloat;
 
         float Odds = EffectiveBaseOdds * (AvgShare / Info.Share);
-        Odds = FMath::Clamp(Odds, MinOdds, MaxOdds);
+        Odds = FMath::Clamp(Odds, MinOdds, FMath::Min(MaxOdds, BettingNetQuantization::MaxOdds));
 
         Info.DecimalOdds = Odds;
     }
+
+    SyncReplicatedColorInfo();
 }
 
 float UColorTerritoryBettingComponent::GetOdds(EBetColor Color) const
@@ -173,3 +289,101 @@ float UColorTerritoryBettingComponent::GetExpectedValueForColor(EBetColor Color,
     const float EVPerStake = p * (Odds - 1.0f) + (1.0f - p) * (-1.0f);
     return Stake * EVPerStake;
 }
+
+float UColorTerritoryBettingComponent::SimulateAndSettleBet(EBetColor Color, float Stake, EBetColor& OutWinningColor, bool& bOutPlayerWon, bool& bOutSettled)
+{
+    float NetWin = 0.0f;
+
+    bOutSettled = SettleBetsBatch(
+        MakeArrayView(&Color, 1),
+        MakeArrayView(&Stake, 1),
+        MakeArrayView(&OutWinningColor, 1),
+        MakeArrayView(&bOutPlayerWon, 1),
+        MakeArrayView(&NetWin, 1));
+
+    return NetWin;
+}
+
+bool UColorTerritoryBettingComponent::SettleBetsBatch(
+    TConstArrayView<EBetColor> Colors,
+    TConstArrayView<float> Stakes,
+    TArrayView<EBetColor> OutWinningColors,
+    TArrayView<bool> OutPlayerWon,
+    TArrayView<float> OutNetWins
+)
+{
+    const int32 NumBets = Stakes.Num();
+    check(Colors.Num() == NumBets && OutWinningColors.Num() == NumBets
+        && OutPlayerWon.Num() == NumBets && OutNetWins.Num() == NumBets);
+
+    for (int32 i = 0; i < NumBets; ++i)
+    {
+        OutPlayerWon[i] = false;
+        OutNetWins[i] = 0.0f;
+    }
+
+    if (!HasBettingAuthority())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ColorTerritoryBettingComponent: bets can only be settled by the server (%s)"),
+            *GetNameSafe(GetOwner()));
+        return false;
+    }
+
+    float CumulativeShares[4];
+    EBetColor ShareColors[4];
+    int32 NumActive = 0;
+    float TotalShare = 0.0f;
+
+    for (const TPair<EBetColor, FColorBetInfo>& Pair : ColorInfo)
+    {
+        if (Pair.Value.Share > 0.0f && NumActive < UE_ARRAY_COUNT(CumulativeShares))
+        {
+            TotalShare += Pair.Value.Share;
+            CumulativeShares[NumActive] = TotalShare;
+            ShareColors[NumActive] = Pair.Key;
+            NumActive++;
+        }
+    }
+
+    if (NumActive == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ColorTerritoryBettingComponent: no territory shares to settle against on %s (%d bets skipped)"),
+            *GetNameSafe(GetOwner()), NumBets);
+        return false;
+    }
+
+    FPayoutHistogram* Histogram = FPayoutStatsRegistry::IsEnabled() ? &StatsBinding.GetHistogram(this) : nullptr;
+
+    for (int32 i = 0; i < NumBets; ++i)
+    {
+        const float Stake = Stakes[i] > 0.0f ? Stakes[i] : DefaultStake;
+
+        const float RandomValue = FMath::FRandRange(0.0f, TotalShare);
+        int32 Slot = 0;
+        while (Slot < NumActive - 1 && RandomValue > CumulativeShares[Slot])
+        {
+            Slot++;
+        }
+
+        OutWinningColors[i] = ShareColors[Slot];
+        OutPlayerWon[i] = (OutWinningColors[i] == Colors[i]);
+
+        const FColorBetInfo* Info = ColorInfo.Find(Colors[i]);
+        const float Odds = Info ? Info->DecimalOdds : 0.0f;
+
+        OutNetWins[i] = (OutPlayerWon[i] && Odds > 0.0f) ? Stake * (Odds - 1.0f) : -Stake;
+
+        if (Histogram)
+        {
+            const float Share = Info ? Info->Share / TotalShare : 0.0f;
+            Histogram->Record(Stake, OutNetWins[i], Stake * Share * Odds);
+        }
+    }
+
+    return true;
+}
+
+FPayoutStatsSnapshot UColorTerritoryBettingComponent::GetPayoutStats() const
+{
+    return StatsBinding.Snapshot(this);
+}
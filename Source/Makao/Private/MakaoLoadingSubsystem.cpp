@@ -0,0 +1,270 @@
+// MakaoLoadingSubsystem.cpp
+
+#include "MakaoLoadingSubsystem.h"
+#include "CoreGlobals.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace MakaoLoading
+{
+    // HandlePostLoadMap ends transitions by the loaded map's short name, so accept full paths here too.
+    FName MakeTransitionPhase(FName LevelName)
+    {
+        return FName(*(TEXT("Transition.") + FPackageName::GetShortName(LevelName.ToString())));
+    }
+}
+
+void UMakaoLoadingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UMakaoLoadingSubsystem::HandlePreLoadMap);
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UMakaoLoadingSubsystem::HandlePostLoadMap);
+}
+
+void UMakaoLoadingSubsystem::Deinitialize()
+{
+    FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+    ReleasePreloadedAssets();
+
+    Super::Deinitialize();
+}
+
+void UMakaoLoadingSubsystem::BeginPhase(FName Phase)
+{
+    OpenPhases.Add(Phase, FPlatformTime::Seconds());
+}
+
+void UMakaoLoadingSubsystem::EndPhase(FName Phase)
+{
+    double StartTime = 0.0;
+    if (!OpenPhases.RemoveAndCopyValue(Phase, StartTime))
+    {
+        return;
+    }
+
+    FMakaoLoadPhaseTiming& Timing = PhaseTimings.AddDefaulted_GetRef();
+    Timing.Phase = Phase;
+    Timing.StartSeconds = StartTime - GStartTime;
+    Timing.DurationSeconds = FPlatformTime::Seconds() - StartTime;
+
+    UE_LOG(LogTemp, Log, TEXT("MakaoLoadingSubsystem: %s took %.1f ms (started %.2f s after launch)"),
+        *Phase.ToString(), Timing.DurationSeconds * 1000.0, Timing.StartSeconds);
+}
+
+void UMakaoLoadingSubsystem::HandlePreLoadMap(const FString& MapName)
+{
+    BeginPhase(FName(*(TEXT("Map.") + FPackageName::GetShortName(MapName))));
+}
+
+void UMakaoLoadingSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+    if (!LoadedWorld || LoadedWorld->GetGameInstance() != GetGameInstance())
+    {
+        return;
+    }
+
+    const FString MapName = UWorld::RemovePIEPrefix(LoadedWorld->GetMapName());
+
+    EndPhase(FName(*(TEXT("Map.") + MapName)));
+    EndPhase(FName(*(TEXT("Transition.") + MapName)));
+
+    if (!bStartupRecorded)
+    {
+        bStartupRecorded = true;
+
+        FMakaoLoadPhaseTiming& Timing = PhaseTimings.AddDefaulted_GetRef();
+        Timing.Phase = FName(TEXT("Startup"));
+        Timing.DurationSeconds = FPlatformTime::Seconds() - GStartTime;
+
+        UE_LOG(LogTemp, Log, TEXT("MakaoLoadingSubsystem: Startup to %s took %.1f ms"),
+            *MapName, Timing.DurationSeconds * 1000.0);
+    }
+
+    if (MapName == PreloadTriggerMap)
+    {
+        StartPreload();
+    }
+}
+
+void UMakaoLoadingSubsystem::StartPreload()
+{
+    if (bPreloadStarted)
+    {
+        return;
+    }
+
+    bPreloadStarted = true;
+    BeginPhase(FName(TEXT("Preload")));
+
+    TArray<const FMakaoPreloadBundle*> SortedBundles;
+    for (const FMakaoPreloadBundle& Bundle : PreloadBundles)
+    {
+        if (Bundle.Assets.Num() > 0)
+        {
+            SortedBundles.Add(&Bundle);
+        }
+    }
+
+    SortedBundles.StableSort([](const FMakaoPreloadBundle& A, const FMakaoPreloadBundle& B)
+    {
+        return A.Priority > B.Priority;
+    });
+
+    // Counted up front: a bundle that is already resident completes inside RequestAsyncLoad.
+    NumBundlesInFlight = SortedBundles.Num() + 1;
+
+    for (const FMakaoPreloadBundle* Bundle : SortedBundles)
+    {
+        BeginPhase(FName(*(TEXT("Preload.") + Bundle->Name.ToString())));
+
+        TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+            Bundle->Assets,
+            FStreamableDelegate::CreateUObject(this, &UMakaoLoadingSubsystem::HandleBundleLoaded, Bundle->Name),
+            Bundle->Priority,
+            false,
+            false,
+            FString::Printf(TEXT("MakaoPreload.%s"), *Bundle->Name.ToString()));
+
+        if (Handle.IsValid())
+        {
+            BundleHandles.Add(Handle);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MakaoLoadingSubsystem: bundle (%s) has no loadable assets"),
+                *Bundle->Name.ToString());
+            HandleBundleLoaded(Bundle->Name);
+        }
+    }
+
+    // Releases the up-front count; finishes immediately if nothing needed loading.
+    HandleBundleLoaded(NAME_None);
+}
+
+void UMakaoLoadingSubsystem::HandleBundleLoaded(FName BundleName)
+{
+    if (!BundleName.IsNone())
+    {
+        EndPhase(FName(*(TEXT("Preload.") + BundleName.ToString())));
+    }
+
+    if (NumBundlesInFlight <= 0 || --NumBundlesInFlight > 0)
+    {
+        return;
+    }
+
+    EndPhase(FName(TEXT("Preload")));
+    OnPreloadComplete.Broadcast();
+
+    if (!PendingLevel.IsNone())
+    {
+        OpenPendingLevel();
+    }
+}
+
+bool UMakaoLoadingSubsystem::IsPreloadComplete() const
+{
+    return bPreloadStarted && NumBundlesInFlight == 0;
+}
+
+float UMakaoLoadingSubsystem::GetPreloadProgress() const
+{
+    if (!bPreloadStarted)
+    {
+        return 0.0f;
+    }
+
+    int32 Loaded = 0;
+    int32 Requested = 0;
+
+    for (const TSharedPtr<FStreamableHandle>& Handle : BundleHandles)
+    {
+        int32 HandleLoaded = 0;
+        int32 HandleRequested = 0;
+        Handle->GetLoadedCount(HandleLoaded, HandleRequested);
+
+        Loaded += HandleLoaded;
+        Requested += HandleRequested;
+    }
+
+    return Requested > 0 ? static_cast<float>(Loaded) / static_cast<float>(Requested) : (IsPreloadComplete() ? 1.0f : 0.0f);
+}
+
+void UMakaoLoadingSubsystem::OpenLevelWhenPreloaded(FName LevelName)
+{
+    if (LevelName.IsNone())
+    {
+        return;
+    }
+
+    // One transition at a time; replacing the pending level would leave its transition phase open.
+    if (!PendingLevel.IsNone())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MakaoLoadingSubsystem: ignoring request to open %s while %s is already pending"),
+            *LevelName.ToString(), *PendingLevel.ToString());
+        return;
+    }
+
+    BeginPhase(MakaoLoading::MakeTransitionPhase(LevelName));
+    PendingLevel = LevelName;
+
+    StartPreload();
+
+    if (IsPreloadComplete())
+    {
+        OpenPendingLevel();
+    }
+}
+
+void UMakaoLoadingSubsystem::OpenPendingLevel()
+{
+    const FName LevelName = PendingLevel;
+    PendingLevel = NAME_None;
+
+    UGameplayStatics::OpenLevel(GetGameInstance(), LevelName);
+}
+
+void UMakaoLoadingSubsystem::ReleasePreloadedAssets()
+{
+    for (const TSharedPtr<FStreamableHandle>& Handle : BundleHandles)
+    {
+        if (Handle->IsLoadingInProgress())
+        {
+            Handle->CancelHandle();
+        }
+        else
+        {
+            Handle->ReleaseHandle();
+        }
+    }
+
+    BundleHandles.Reset();
+    NumBundlesInFlight = 0;
+    bPreloadStarted = false;
+
+    // Cancelled handles never call back, so nothing will finish the preload phases or open the pending level.
+    if (!PendingLevel.IsNone())
+    {
+        OpenPhases.Remove(MakaoLoading::MakeTransitionPhase(PendingLevel));
+        PendingLevel = NAME_None;
+    }
+
+    for (auto It = OpenPhases.CreateIterator(); It; ++It)
+    {
+        if (It.Key().ToString().StartsWith(TEXT("Preload")))
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+TArray<FMakaoLoadPhaseTiming> UMakaoLoadingSubsystem::GetLoadPhaseTimings() const
+{
+    return PhaseTimings;
+}
@@ -0,0 +1,173 @@
+// OddsFormatSubsystem.cpp
+
+#include "OddsFormatSubsystem.h"
+#include "BettingNetQuantization.h"
+#include "Internationalization/Culture.h"
+#include "Internationalization/Internationalization.h"
+#include "Math/UnrealMathUtility.h"
+
+#define LOCTEXT_NAMESPACE "OddsFormat"
+
+void UOddsFormatSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    BuildFractionTable();
+
+    CultureChangedHandle = FInternationalization::Get().OnCultureChanged().AddUObject(this, &UOddsFormatSubsystem::HandleCultureChanged);
+    HandleCultureChanged();
+}
+
+void UOddsFormatSubsystem::Deinitialize()
+{
+    FInternationalization::Get().OnCultureChanged().Remove(CultureChangedHandle);
+
+    CurrentCache = nullptr;
+    CacheByCulture.Empty();
+    FractionTable.Empty();
+
+    Super::Deinitialize();
+}
+
+// For every odds step, picks the fraction with the smallest conventional denominator that still
+// rounds back to the same odds, so 1.91 shows as 10/11 rather than 91/100.
+void UOddsFormatSubsystem::BuildFractionTable()
+{
+    static const uint16 Denominators[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 20, 25, 30, 40, 50, 100 };
+
+    FractionTable.SetNum(MaxFractionTableOdds + 1);
+
+    for (int32 Quantized = 101; Quantized <= MaxFractionTableOdds; ++Quantized)
+    {
+        const double Target = static_cast<double>(Quantized - 100) / BettingNetQuantization::OddsScale;
+
+        FFraction Best;
+        Best.Numerator = static_cast<uint16>(Quantized - 100);
+        Best.Denominator = 100;
+
+        for (const uint16 Denominator : Denominators)
+        {
+            const int32 Numerator = FMath::RoundToInt(Target * Denominator);
+            if (Numerator <= 0 || Numerator > MAX_uint16)
+            {
+                continue;
+            }
+
+            const double FractionOdds = 1.0 + static_cast<double>(Numerator) / Denominator;
+            if (FMath::RoundToInt(FractionOdds * BettingNetQuantization::OddsScale) == Quantized)
+            {
+                Best.Numerator = static_cast<uint16>(Numerator);
+                Best.Denominator = Denominator;
+                break;
+            }
+        }
+
+        const int32 Divisor = FMath::GreatestCommonDivisor(static_cast<int32>(Best.Numerator), static_cast<int32>(Best.Denominator));
+        Best.Numerator = static_cast<uint16>(Best.Numerator / Divisor);
+        Best.Denominator = static_cast<uint16>(Best.Denominator / Divisor);
+
+        FractionTable[Quantized] = Best;
+    }
+}
+
+// Keyed on language and locale together: LOCTEXT patterns follow the language,
+// while FText::AsNumber formats with the locale.
+void UOddsFormatSubsystem::HandleCultureChanged()
+{
+    const FInternationalization& I18N = FInternationalization::Get();
+    const FString CacheKey = I18N.GetCurrentLanguage()->GetName() + TEXT("|") + I18N.GetCurrentLocale()->GetName();
+
+    CurrentCache = &CacheByCulture.FindOrAdd(CacheKey);
+}
+
+void UOddsFormatSubsystem::ClearCache()
+{
+    CacheByCulture.Empty();
+    HandleCultureChanged();
+}
+
+FText UOddsFormatSubsystem::FormatOdds(float DecimalOdds, EOddsFormat Format)
+{
+    const uint16 QuantizedOdds = BettingNetQuantization::QuantizeOdds(DecimalOdds);
+    const uint32 Key = (static_cast<uint32>(QuantizedOdds) << 8) | static_cast<uint32>(Format);
+
+    if (!CurrentCache)
+    {
+        HandleCultureChanged();
+    }
+
+    if (const FText* Cached = CurrentCache->Find(Key))
+    {
+        return *Cached;
+    }
+
+    return CurrentCache->Add(Key, BuildText(QuantizedOdds, Format));
+}
+
+FText UOddsFormatSubsystem::FormatColorBetOdds(const FColorBetInfo& BetInfo, EOddsFormat Format)
+{
+    return FormatOdds(BetInfo.DecimalOdds, Format);
+}
+
+FText UOddsFormatSubsystem::FormatOutcomeOdds(const FBetOutcomeOption& Option, EOddsFormat Format)
+{
+    return FormatOdds(Option.DecimalOdds, Format);
+}
+
+FText UOddsFormatSubsystem::BuildText(uint16 QuantizedOdds, EOddsFormat Format) const
+{
+    // Odds of 1.00 or less can't be bet on (e.g. a colour with no territory).
+    if (QuantizedOdds <= 100)
+    {
+        return LOCTEXT("OddsUnavailable", "-");
+    }
+
+    const float Odds = BettingNetQuantization::DequantizeOdds(QuantizedOdds);
+
+    switch (Format)
+    {
+    case EOddsFormat::Fractional:
+    {
+        int32 Numerator = 0;
+        int32 Denominator = 1;
+
+        if (FractionTable.IsValidIndex(QuantizedOdds))
+        {
+            Numerator = FractionTable[QuantizedOdds].Numerator;
+            Denominator = FractionTable[QuantizedOdds].Denominator;
+        }
+        else
+        {
+            Numerator = FMath::RoundToInt(Odds - 1.0f);
+        }
+
+        return FText::Format(LOCTEXT("FractionalOdds", "{0}/{1}"), FText::AsNumber(Numerator), FText::AsNumber(Denominator));
+    }
+
+    case EOddsFormat::American:
+    {
+        FNumberFormattingOptions Options;
+        Options.SetMaximumFractionalDigits(0);
+        Options.SetUseGrouping(false);
+
+        if (Odds >= 2.0f)
+        {
+            return FText::Format(LOCTEXT("AmericanOddsPositive", "+{0}"), FText::AsNumber(FMath::RoundToInt((Odds - 1.0f) * 100.0f), &Options));
+        }
+
+        return FText::Format(LOCTEXT("AmericanOddsNegative", "-{0}"), FText::AsNumber(FMath::RoundToInt(100.0f / (Odds - 1.0f)), &Options));
+    }
+
+    case EOddsFormat::Decimal:
+    default:
+    {
+        FNumberFormattingOptions Options;
+        Options.SetMinimumFractionalDigits(2);
+        Options.SetMaximumFractionalDigits(2);
+
+        return FText::AsNumber(Odds, &Options);
+    }
+    }
+}
+
+#undef LOCTEXT_NAMESPACE
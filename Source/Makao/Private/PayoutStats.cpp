@@ -0,0 +1,357 @@
+// PayoutStats.cpp
+
+#include "PayoutStats.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/UnrealMathUtility.h"
+
+static TAutoConsoleVariable<bool> CVarPayoutStatsEnabled(
+    TEXT("Makao.Stats.Enabled"),
+    true,
+    TEXT("Record per-game payout histograms and RTP for betting components."));
+
+FPayoutHistogram::FPayoutHistogram(FName InGameId)
+    : GameId(InGameId)
+    , Shards(MakeUnique<FShard[]>(NumShards))
+{
+    Reset();
+}
+
+int32 FPayoutHistogram::GetBucketIndex(uint64 Value)
+{
+    if (Value < static_cast<uint64>(SubBucketCount))
+    {
+        return static_cast<int32>(Value);
+    }
+
+    // Keep the top SubBucketBits bits of the value: the leading one plus SubBucketBits - 1 bits of mantissa.
+    const int32 Shift = static_cast<int32>(FMath::FloorLog2_64(Value)) - (SubBucketBits - 1);
+    if (Shift > MaxShift)
+    {
+        return NumBuckets - 1;
+    }
+
+    return SubBucketCount + (Shift - 1) * SubBucketHalf + static_cast<int32>((Value >> Shift) - SubBucketHalf);
+}
+
+uint64 FPayoutHistogram::GetBucketLowerBound(int32 BucketIndex)
+{
+    if (BucketIndex < SubBucketCount)
+    {
+        return static_cast<uint64>(BucketIndex);
+    }
+
+    const int32 Shift = (BucketIndex - SubBucketCount) / SubBucketHalf + 1;
+    const uint64 Mantissa = static_cast<uint64>((BucketIndex - SubBucketCount) % SubBucketHalf + SubBucketHalf);
+    return Mantissa << Shift;
+}
+
+uint64 FPayoutHistogram::GetBucketUpperBound(int32 BucketIndex)
+{
+    if (BucketIndex < SubBucketCount)
+    {
+        return static_cast<uint64>(BucketIndex);
+    }
+
+    const int32 Shift = (BucketIndex - SubBucketCount) / SubBucketHalf + 1;
+    const uint64 Mantissa = static_cast<uint64>((BucketIndex - SubBucketCount) % SubBucketHalf + SubBucketHalf);
+    return ((Mantissa + 1) << Shift) - 1;
+}
+
+FPayoutHistogram::FShard& FPayoutHistogram::GetLocalShard()
+{
+    static std::atomic<uint32> NextShard{ 0 };
+    static thread_local const uint32 ThreadShard = NextShard.fetch_add(1, std::memory_order_relaxed) % NumShards;
+
+    return Shards[ThreadShard];
+}
+
+void FPayoutHistogram::Record(float Stake, float NetWin, float ExpectedReturn)
+{
+    if (Stake <= 0.0f)
+    {
+        return;
+    }
+
+    const float Returned = FMath::Max(0.0f, Stake + NetWin);
+
+    FShard& Shard = GetLocalShard();
+
+    const uint64 ReturnedFixed = static_cast<uint64>(FMath::RoundToDouble(Returned * FixedPointScale));
+    Shard.Buckets[GetBucketIndex(ReturnedFixed)].fetch_add(1, std::memory_order_relaxed);
+
+    Shard.Rounds.fetch_add(1, std::memory_order_relaxed);
+    Shard.Staked.fetch_add(static_cast<int64>(FMath::RoundToDouble(Stake * FixedPointScale)), std::memory_order_relaxed);
+    Shard.Returned.fetch_add(static_cast<int64>(ReturnedFixed), std::memory_order_relaxed);
+    Shard.ExpectedReturned.fetch_add(static_cast<int64>(FMath::RoundToDouble(ExpectedReturn * FixedPointScale)), std::memory_order_relaxed);
+
+    if (NetWin > 0.0f)
+    {
+        Shard.Hits.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void FPayoutHistogram::Reset()
+{
+    for (int32 ShardIndex = 0; ShardIndex < NumShards; ++ShardIndex)
+    {
+        FShard& Shard = Shards[ShardIndex];
+
+        for (std::atomic<uint64>& Bucket : Shard.Buckets)
+        {
+            Bucket.store(0, std::memory_order_relaxed);
+        }
+
+        Shard.Rounds.store(0, std::memory_order_relaxed);
+        Shard.Hits.store(0, std::memory_order_relaxed);
+        Shard.Staked.store(0, std::memory_order_relaxed);
+        Shard.Returned.store(0, std::memory_order_relaxed);
+        Shard.ExpectedReturned.store(0, std::memory_order_relaxed);
+    }
+}
+
+FPayoutStatsSnapshot FPayoutHistogram::Snapshot() const
+{
+    FPayoutStatsSnapshot Result;
+    Result.GameId = GameId;
+
+    TArray<uint64> Merged;
+    Merged.SetNumZeroed(NumBuckets);
+
+    int64 Hits = 0;
+    int64 Staked = 0;
+    int64 Returned = 0;
+    int64 ExpectedReturned = 0;
+
+    for (int32 ShardIndex = 0; ShardIndex < NumShards; ++ShardIndex)
+    {
+        const FShard& Shard = Shards[ShardIndex];
+
+        for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+        {
+            Merged[BucketIndex] += Shard.Buckets[BucketIndex].load(std::memory_order_relaxed);
+        }
+
+        Result.Rounds += Shard.Rounds.load(std::memory_order_relaxed);
+        Hits += Shard.Hits.load(std::memory_order_relaxed);
+        Staked += Shard.Staked.load(std::memory_order_relaxed);
+        Returned += Shard.Returned.load(std::memory_order_relaxed);
+        ExpectedReturned += Shard.ExpectedReturned.load(std::memory_order_relaxed);
+    }
+
+    Result.TotalStaked = static_cast<double>(Staked) / FixedPointScale;
+    Result.TotalReturned = static_cast<double>(Returned) / FixedPointScale;
+
+    if (Staked > 0)
+    {
+        Result.RTP = static_cast<double>(Returned) / static_cast<double>(Staked);
+        Result.ExpectedRTP = static_cast<double>(ExpectedReturned) / static_cast<double>(Staked);
+    }
+
+    // Shards are read without a barrier, so bucket totals can run slightly ahead of Rounds.
+    uint64 TotalCount = 0;
+    for (const uint64 Count : Merged)
+    {
+        TotalCount += Count;
+    }
+
+    if (TotalCount == 0)
+    {
+        return Result;
+    }
+
+    Result.HitRate = static_cast<double>(Hits) / static_cast<double>(TotalCount);
+
+    auto BucketValue = [](int32 BucketIndex)
+    {
+        const uint64 Mid = (GetBucketLowerBound(BucketIndex) + GetBucketUpperBound(BucketIndex)) / 2;
+        return static_cast<float>(static_cast<double>(Mid) / FixedPointScale);
+    };
+
+    const double Percentiles[] = { 0.5, 0.9, 0.99 };
+    float* Outputs[] = { &Result.PayoutP50, &Result.PayoutP90, &Result.PayoutP99 };
+    constexpr int32 NumPercentiles = UE_ARRAY_COUNT(Percentiles);
+
+    int32 NextPercentile = 0;
+    uint64 Cumulative = 0;
+
+    for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+    {
+        if (Merged[BucketIndex] == 0)
+        {
+            continue;
+        }
+
+        Cumulative += Merged[BucketIndex];
+
+        while (NextPercentile < NumPercentiles
+            && static_cast<double>(Cumulative) >= Percentiles[NextPercentile] * static_cast<double>(TotalCount))
+        {
+            *Outputs[NextPercentile] = BucketValue(BucketIndex);
+            NextPercentile++;
+        }
+
+        Result.PayoutMax = BucketValue(BucketIndex);
+    }
+
+    return Result;
+}
+
+FPayoutStatsRegistry& FPayoutStatsRegistry::Get()
+{
+    static FPayoutStatsRegistry Registry;
+    return Registry;
+}
+
+bool FPayoutStatsRegistry::IsEnabled()
+{
+    return CVarPayoutStatsEnabled.GetValueOnAnyThread();
+}
+
+FName FPayoutStatsRegistry::MakeGameId(const UActorComponent* Component, FName ConfiguredId)
+{
+    if (!ConfiguredId.IsNone() || !Component)
+    {
+        return ConfiguredId;
+    }
+
+    // Default to "<OwnerClass>.<ComponentName>" so every instance of e.g. BP_WheelOfFortune shares one histogram.
+    const AActor* Owner = Component->GetOwner();
+    const FString OwnerClass = Owner ? Owner->GetClass()->GetName() : FString(TEXT("None"));
+    return FName(*FString::Printf(TEXT("%s.%s"), *OwnerClass, *Component->GetName()));
+}
+
+TSharedRef<FPayoutHistogram, ESPMode::ThreadSafe> FPayoutStatsRegistry::FindOrAdd(FName GameId)
+{
+    {
+        FReadScopeLock ReadLock(Lock);
+        if (const TSharedRef<FPayoutHistogram, ESPMode::ThreadSafe>* Existing = Histograms.Find(GameId))
+        {
+            return *Existing;
+        }
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+    if (const TSharedRef<FPayoutHistogram, ESPMode::ThreadSafe>* Existing = Histograms.Find(GameId))
+    {
+        return *Existing;
+    }
+
+    return Histograms.Add(GameId, MakeShared<FPayoutHistogram, ESPMode::ThreadSafe>(GameId));
+}
+
+TSharedPtr<FPayoutHistogram, ESPMode::ThreadSafe> FPayoutStatsRegistry::Find(FName GameId) const
+{
+    FReadScopeLock ReadLock(Lock);
+    if (const TSharedRef<FPayoutHistogram, ESPMode::ThreadSafe>* Existing = Histograms.Find(GameId))
+    {
+        return *Existing;
+    }
+    return nullptr;
+}
+
+TArray<FPayoutStatsSnapshot> FPayoutStatsRegistry::SnapshotAll() const
+{
+    TArray<TSharedRef<FPayoutHistogram, ESPMode::ThreadSafe>> Copy;
+    {
+        FReadScopeLock ReadLock(Lock);
+        Histograms.GenerateValueArray(Copy);
+    }
+
+    TArray<FPayoutStatsSnapshot> Result;
+    Result.Reserve(Copy.Num());
+    for (const TSharedRef<FPayoutHistogram, ESPMode::ThreadSafe>& Histogram : Copy)
+    {
+        Result.Add(Histogram->Snapshot());
+    }
+    return Result;
+}
+
+void FPayoutStatsRegistry::ResetAll()
+{
+    FReadScopeLock ReadLock(Lock);
+    for (const TPair<FName, TSharedRef<FPayoutHistogram, ESPMode::ThreadSafe>>& Pair : Histograms)
+    {
+        Pair.Value->Reset();
+    }
+}
+
+FPayoutHistogram& FPayoutStatsBinding::GetHistogram(const UActorComponent* Component)
+{
+    if (!Histogram)
+    {
+        Histogram = FPayoutStatsRegistry::Get().FindOrAdd(FPayoutStatsRegistry::MakeGameId(Component, GameId));
+    }
+    return *Histogram;
+}
+
+FPayoutStatsSnapshot FPayoutStatsBinding::Snapshot(const UActorComponent* Component) const
+{
+    if (!Histogram)
+    {
+        const FName ResolvedId = FPayoutStatsRegistry::MakeGameId(Component, GameId);
+
+        Histogram = FPayoutStatsRegistry::Get().Find(ResolvedId);
+        if (!Histogram)
+        {
+            FPayoutStatsSnapshot Empty;
+            Empty.GameId = ResolvedId;
+            return Empty;
+        }
+    }
+    return Histogram->Snapshot();
+}
+
+bool UPayoutStatsLibrary::GetPayoutStats(FName GameId, FPayoutStatsSnapshot& OutStats)
+{
+    const TSharedPtr<FPayoutHistogram, ESPMode::ThreadSafe> Histogram = FPayoutStatsRegistry::Get().Find(GameId);
+    if (!Histogram)
+    {
+        OutStats = FPayoutStatsSnapshot();
+        return false;
+    }
+
+    OutStats = Histogram->Snapshot();
+    return true;
+}
+
+TArray<FPayoutStatsSnapshot> UPayoutStatsLibrary::GetAllPayoutStats()
+{
+    return FPayoutStatsRegistry::Get().SnapshotAll();
+}
+
+void UPayoutStatsLibrary::ResetAllPayoutStats()
+{
+    FPayoutStatsRegistry::Get().ResetAll();
+}
+
+static FAutoConsoleCommand CmdPayoutStatsDump(
+    TEXT("Makao.Stats.Dump"),
+    TEXT("Print payout statistics (RTP, expected RTP, hit rate, payout percentiles) for every game."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        const TArray<FPayoutStatsSnapshot> AllStats = FPayoutStatsRegistry::Get().SnapshotAll();
+        if (AllStats.Num() == 0)
+        {
+            UE_LOG(LogTemp, Display, TEXT("PayoutStats: no rounds recorded."));
+            return;
+        }
+
+        for (const FPayoutStatsSnapshot& Stats : AllStats)
+        {
+            UE_LOG(LogTemp, Display,
+                TEXT("PayoutStats %s: rounds=%lld staked=%.2f returned=%.2f RTP=%.4f expected=%.4f drift=%+.4f hit=%.3f p50=%.2f p90=%.2f p99=%.2f max=%.2f"),
+                *Stats.GameId.ToString(), Stats.Rounds, Stats.TotalStaked, Stats.TotalReturned,
+                Stats.RTP, Stats.ExpectedRTP, Stats.RTP - Stats.ExpectedRTP, Stats.HitRate,
+                Stats.PayoutP50, Stats.PayoutP90, Stats.PayoutP99, Stats.PayoutMax);
+        }
+    }));
+
+static FAutoConsoleCommand CmdPayoutStatsReset(
+    TEXT("Makao.Stats.Reset"),
+    TEXT("Clear all payout statistics."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        FPayoutStatsRegistry::Get().ResetAll();
+    }));
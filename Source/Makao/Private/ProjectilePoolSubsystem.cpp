@@ -0,0 +1,307 @@
+// ProjectilePoolSubsystem.cpp
+
+#include "ProjectilePoolSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+
+bool UProjectilePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UProjectilePoolSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectilePoolSubsystem, STATGROUP_Tickables);
+}
+
+void UProjectilePoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    UClass* ProjectileClass = ResolveDefaultProjectileClass();
+    if (ProjectileClass && PrewarmCount > 0)
+    {
+        PrewarmPool(ProjectileClass, PrewarmCount);
+    }
+}
+
+UClass* UProjectilePoolSubsystem::ResolveDefaultProjectileClass()
+{
+    if (LoadedDefaultClass || DefaultProjectileClass.IsNull())
+    {
+        return LoadedDefaultClass;
+    }
+
+    LoadedDefaultClass = DefaultProjectileClass.LoadSynchronous();
+    if (!LoadedDefaultClass)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ProjectilePoolSubsystem: couldn't load default projectile class (%s)"),
+            *DefaultProjectileClass.ToString());
+    }
+
+    return LoadedDefaultClass;
+}
+
+void UProjectilePoolSubsystem::Deinitialize()
+{
+    Pools.Empty();
+    LoadedDefaultClass = nullptr;
+    ActiveActors.Empty();
+    ActivePositions.Empty();
+    ActiveVelocities.Empty();
+    ActiveLifetimes.Empty();
+    ActiveBatched.Empty();
+    ActiveSerials.Empty();
+
+    Super::Deinitialize();
+}
+
+AActor* UProjectilePoolSubsystem::SpawnPooledActor(UClass* ProjectileClass)
+{
+    UWorld* World = GetWorld();
+    if (!World || !ProjectileClass)
+    {
+        return nullptr;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    AActor* Actor = World->SpawnActor<AActor>(ProjectileClass, FTransform::Identity, SpawnParams);
+    if (!Actor)
+    {
+        return nullptr;
+    }
+
+    // Pooled actors must never expire on their own; the pool tracks lifetime.
+    Actor->SetLifeSpan(0.0f);
+
+    DeactivateActor(Actor);
+    return Actor;
+}
+
+void UProjectilePoolSubsystem::PrewarmPool(TSubclassOf<AActor> ProjectileClass, int32 Count)
+{
+    if (!ProjectileClass || Count <= 0)
+    {
+        return;
+    }
+
+    FProjectilePoolBucket& Bucket = Pools.FindOrAdd(ProjectileClass.Get());
+    Bucket.InactiveActors.Reserve(Bucket.InactiveActors.Num() + Count);
+
+    for (int32 i = 0; i < Count; ++i)
+    {
+        if (AActor* Actor = SpawnPooledActor(ProjectileClass))
+        {
+            Bucket.InactiveActors.Add(Actor);
+        }
+    }
+}
+
+AActor* UProjectilePoolSubsystem::FireProjectile(
+    TSubclassOf<AActor> ProjectileClass,
+    const FTransform& SpawnTransform,
+    float Speed,
+    AActor* Instigator,
+    float Lifetime,
+    bool bBatchedMovement
+)
+{
+    if (!ProjectileClass)
+    {
+        ProjectileClass = ResolveDefaultProjectileClass();
+    }
+
+    if (!ProjectileClass)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ProjectilePoolSubsystem: no projectile class to fire."));
+        return nullptr;
+    }
+
+    FProjectilePoolBucket& Bucket = Pools.FindOrAdd(ProjectileClass.Get());
+
+    AActor* Actor = nullptr;
+    while (!Actor && Bucket.InactiveActors.Num() > 0)
+    {
+        // Something outside the pool may have destroyed an inactive actor.
+        AActor* Candidate = Bucket.InactiveActors.Pop(EAllowShrinking::No);
+        if (IsValid(Candidate))
+        {
+            Actor = Candidate;
+        }
+    }
+
+    if (!Actor)
+    {
+        Actor = SpawnPooledActor(ProjectileClass);
+        if (!Actor)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ProjectilePoolSubsystem: couldn't spawn projectile (%s)"),
+                *ProjectileClass->GetName());
+            return nullptr;
+        }
+    }
+
+    const FVector Velocity = SpawnTransform.GetRotation().GetForwardVector() * Speed;
+
+    ActivateActor(Actor, SpawnTransform, Velocity, Instigator, bBatchedMovement);
+
+    ActiveActors.Add(Actor);
+    ActivePositions.Add(SpawnTransform.GetLocation());
+    ActiveVelocities.Add(Velocity);
+    ActiveLifetimes.Add(Lifetime > 0.0f ? Lifetime : DefaultLifetime);
+    ActiveBatched.Add(bBatchedMovement);
+    ActiveSerials.Add(++NextActivationSerial);
+
+    return Actor;
+}
+
+void UProjectilePoolSubsystem::ActivateActor(AActor* Actor, const FTransform& SpawnTransform, const FVector& Velocity, AActor* Instigator, bool bBatchedMovement)
+{
+    Actor->SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+    Actor->SetInstigator(Cast<APawn>(Instigator));
+    Actor->SetOwner(Instigator);
+    Actor->SetActorHiddenInGame(false);
+    Actor->SetActorEnableCollision(true);
+    Actor->SetActorTickEnabled(!bBatchedMovement);
+
+    if (UProjectileMovementComponent* Movement = Actor->FindComponentByClass<UProjectileMovementComponent>())
+    {
+        if (bBatchedMovement)
+        {
+            Movement->Deactivate();
+        }
+        else
+        {
+            Movement->SetUpdatedComponent(Actor->GetRootComponent());
+            Movement->Velocity = Velocity;
+            Movement->Activate(true);
+            Movement->UpdateComponentVelocity();
+        }
+    }
+}
+
+void UProjectilePoolSubsystem::DeactivateActor(AActor* Actor)
+{
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+
+    if (UProjectileMovementComponent* Movement = Actor->FindComponentByClass<UProjectileMovementComponent>())
+    {
+        Movement->StopMovementImmediately();
+        Movement->Deactivate();
+    }
+}
+
+void UProjectilePoolSubsystem::ReleaseProjectile(AActor* Projectile)
+{
+    const int32 ActiveIndex = ActiveActors.Find(Projectile);
+    if (ActiveIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    ReleaseActiveAt(ActiveIndex);
+}
+
+void UProjectilePoolSubsystem::ReleaseActiveAt(int32 ActiveIndex)
+{
+    AActor* Actor = ActiveActors[ActiveIndex];
+
+    ActiveActors.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+    ActivePositions.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+    ActiveVelocities.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+    ActiveLifetimes.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+    ActiveBatched.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+    ActiveSerials.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+
+    DeactivateActor(Actor);
+    Pools.FindOrAdd(Actor->GetClass()).InactiveActors.Add(Actor);
+}
+
+int32 UProjectilePoolSubsystem::GetNumActiveProjectiles() const
+{
+    return ActiveActors.Num();
+}
+
+void UProjectilePoolSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    UWorld* World = GetWorld();
+    if (!World || ActiveActors.Num() == 0)
+    {
+        return;
+    }
+
+    // Hits are reported after the loop, because handlers may fire or release projectiles.
+    struct FPendingHit
+    {
+        AActor* Actor;
+        uint32 Serial;
+        FHitResult Hit;
+    };
+
+    TArray<FPendingHit, TInlineAllocator<8>> Hits;
+
+    // Walk backwards so swap-removal never skips an entry.
+    for (int32 i = ActiveActors.Num() - 1; i >= 0; --i)
+    {
+        AActor* Actor = ActiveActors[i];
+
+        ActiveLifetimes[i] -= DeltaTime;
+        if (!IsValid(Actor) || ActiveLifetimes[i] <= 0.0f)
+        {
+            ReleaseActiveAt(i);
+            continue;
+        }
+
+        if (!ActiveBatched[i])
+        {
+            continue;
+        }
+
+        const FVector Start = ActivePositions[i];
+        const FVector End = Start + ActiveVelocities[i] * DeltaTime;
+
+        FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PooledProjectileTrace), false, Actor);
+        QueryParams.AddIgnoredActor(Actor->GetOwner());
+
+        FHitResult Hit;
+        if (World->LineTraceSingleByChannel(Hit, Start, End, BatchedTraceChannel, QueryParams))
+        {
+            Hits.Add({ Actor, ActiveSerials[i], Hit });
+            continue;
+        }
+
+        ActivePositions[i] = End;
+        Actor->SetActorLocation(End, false, nullptr, ETeleportType::None);
+    }
+
+    // Handlers still see the projectile active; it goes back to the pool afterwards unless a handler already
+    // released it. A matching serial means it's still the same shot, not one re-fired from the pool by a handler.
+    for (const FPendingHit& Hit : Hits)
+    {
+        if (!IsValid(Hit.Actor))
+        {
+            continue;
+        }
+
+        OnProjectileHit.Broadcast(Hit.Actor, Hit.Hit);
+
+        const int32 ActiveIndex = ActiveActors.Find(Hit.Actor);
+        if (ActiveIndex != INDEX_NONE && ActiveSerials[ActiveIndex] == Hit.Serial)
+        {
+            ReleaseActiveAt(ActiveIndex);
+        }
+    }
+}
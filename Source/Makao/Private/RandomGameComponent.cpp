@@ -1,6 +1,7 @@
 // RandomGameComponent.cpp
 
 #include "RandomGameComponent.h"
+#include "Algo/BinarySearch.h"
 #include "Math/UnrealMathUtility.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
@@ -38,65 +39,74 @@ float URandomGameComponent::GetTotalWeight() const
 
 float URandomGameComponent::PlayRound(float Stake, FRandomGameOutcome& OutChosenOutcome)
 {
-    if (Stake <= 0.0f)
-    {
-        Stake = DefaultStake;
-    }
-
-    const float TotalWeight = GetTotalWeight();
+    int32 OutcomeIndex = INDEX_NONE;
+    return PlayRoundWithIndex(Stake, OutChosenOutcome, OutcomeIndex);
+}
 
-    if (TotalWeight <= 0.0f || Outcomes.Num() == 0)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("RandomGameComponent: weight sum <= 0 or no outcomes found."));
-        OutChosenOutcome = FRandomGameOutcome();
-        return 0.0f;
-    }
+float URandomGameComponent::PlayRoundWithIndex(float Stake, FRandomGameOutcome& OutChosenOutcome, int32& OutOutcomeIndex)
+{
+    float NetWin = 0.0f;
 
-    const float RandomValue = FMath::FRandRange(0.0f, TotalWeight);
-    float Accumulated = 0.0f;
+    PlayRoundsBatch(
+        MakeArrayView(&Stake, 1),
+        MakeArrayView(&OutOutcomeIndex, 1),
+        MakeArrayView(&NetWin, 1));
 
-    const FRandomGameOutcome* SelectedOutcome = nullptr;
+    OutChosenOutcome = Outcomes.IsValidIndex(OutOutcomeIndex) ? Outcomes[OutOutcomeIndex] : FRandomGameOutcome();
+    return NetWin;
+}
 
-    for (const FRandomGameOutcome& Outcome : Outcomes)
-    {
-        if (Outcome.ProbabilityWeight <= 0.0f)
-        {
-            continue;
-        }
+void URandomGameComponent::PlayRoundsBatch(TConstArrayView<float> Stakes, TArrayView<int32> OutOutcomeIndices, TArrayView<float> OutNetWins)
+{
+    check(OutOutcomeIndices.Num() == Stakes.Num() && OutNetWins.Num() == Stakes.Num());
 
-        Accumulated += Outcome.ProbabilityWeight;
+    TArray<float, TInlineAllocator<16>> CumulativeWeights;
+    TArray<int32, TInlineAllocator<16>> WeightedIndices;
+    float TotalWeight = 0.0f;
 
-        if (RandomValue <= Accumulated)
+    for (int32 i = 0; i < Outcomes.Num(); ++i)
+    {
+        if (Outcomes[i].ProbabilityWeight > 0.0f)
         {
-            SelectedOutcome = &Outcome;
-            break;
+            TotalWeight += Outcomes[i].ProbabilityWeight;
+            CumulativeWeights.Add(TotalWeight);
+            WeightedIndices.Add(i);
         }
     }
 
-    if (!SelectedOutcome)
+    if (WeightedIndices.Num() == 0)
     {
-        for (int32 i = Outcomes.Num() - 1; i >= 0; --i)
+        UE_LOG(LogTemp, Warning, TEXT("RandomGameComponent: weight sum <= 0 or no outcomes found (%d rounds skipped)."),
+            Stakes.Num());
+
+        for (int32 i = 0; i < Stakes.Num(); ++i)
         {
-            if (Outcomes[i].ProbabilityWeight > 0.0f)
-            {
-                SelectedOutcome = &Outcomes[i];
-                break;
-            }
+            OutOutcomeIndices[i] = INDEX_NONE;
+            OutNetWins[i] = 0.0f;
         }
+        return;
     }
 
-    if (!SelectedOutcome)
+    FPayoutHistogram* Histogram = FPayoutStatsRegistry::IsEnabled() ? &StatsBinding.GetHistogram(this) : nullptr;
+    const float ExpectedMultiplier = Histogram ? ComputeExpectedValue(1.0f) : 0.0f;
+
+    for (int32 i = 0; i < Stakes.Num(); ++i)
     {
-        UE_LOG(LogTemp, Warning, TEXT("RandomGameComponent: unable to choose outcome."));
-        OutChosenOutcome = FRandomGameOutcome();
-        return 0.0f;
-    }
+        const float Stake = Stakes[i] > 0.0f ? Stakes[i] : DefaultStake;
 
-    OutChosenOutcome = *SelectedOutcome;
+        // First cumulative weight >= roll.
+        const float RandomValue = FMath::FRandRange(0.0f, TotalWeight);
+        const int32 Slot = FMath::Min(Algo::LowerBound(CumulativeWeights, RandomValue), WeightedIndices.Num() - 1);
+        const int32 OutcomeIndex = WeightedIndices[Slot];
 
-    const float NetWin = Stake * SelectedOutcome->PayoutMultiplier;
+        OutOutcomeIndices[i] = OutcomeIndex;
+        OutNetWins[i] = Stake * Outcomes[OutcomeIndex].PayoutMultiplier;
 
-    return NetWin;
+        if (Histogram)
+        {
+            Histogram->Record(Stake, OutNetWins[i], Stake * (1.0f + ExpectedMultiplier));
+        }
+    }
 }
 
 float URandomGameComponent::ComputeExpectedValue(float Stake) const
@@ -129,3 +139,8 @@ float URandomGameComponent::ComputeExpectedValue(float Stake) const
     const float EV = Stake * EVMultiplier;
     return EV;
 }
+
+FPayoutStatsSnapshot URandomGameComponent::GetPayoutStats() const
+{
+    return StatsBinding.Snapshot(this);
+}
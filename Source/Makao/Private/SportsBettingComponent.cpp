@@ -1,13 +1,48 @@
 // SportsBettingComponent.cpp
 
 #include "SportsBettingComponent.h"
+#include "BettingNetQuantization.h"
+#include "Algo/BinarySearch.h"
 #include "Math/UnrealMathUtility.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "Net/UnrealNetwork.h"
+
+void FSportsOddsNetItem::PostReplicatedAdd(const FSportsOddsNetArray& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->ApplyReplicatedItem(*this);
+    }
+}
+
+void FSportsOddsNetItem::PostReplicatedChange(const FSportsOddsNetArray& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->ApplyReplicatedItem(*this);
+    }
+}
 
 USportsBettingComponent::USportsBettingComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
+
+    SetIsReplicatedByDefault(true);
+}
+
+void USportsBettingComponent::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    ReplicatedOdds.OwnerComponent = this;
+}
+
+void USportsBettingComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(USportsBettingComponent, ReplicatedOdds);
 }
 
 void USportsBettingComponent::BeginPlay()
@@ -19,6 +54,96 @@ void USportsBettingComponent::BeginPlay()
         UE_LOG(LogTemp, Warning, TEXT("SportsBettingComponent: no configured events on %s"),
             *GetOwner()->GetName());
     }
+
+    RefreshReplicatedOdds();
+}
+
+bool USportsBettingComponent::HasBettingAuthority() const
+{
+    const AActor* Owner = GetOwner();
+    return Owner && Owner->HasAuthority();
+}
+
+bool USportsBettingComponent::HasReceivedServerState() const
+{
+    return HasBettingAuthority() || bHasReceivedServerState;
+}
+
+void USportsBettingComponent::RefreshReplicatedOdds()
+{
+    for (FSportsEventConfig& Event : Events)
+    {
+        SyncReplicatedOdds(Event);
+    }
+}
+
+void USportsBettingComponent::SyncReplicatedOdds(FSportsEventConfig& Event)
+{
+    if (!HasBettingAuthority() || !GetIsReplicated())
+    {
+        return;
+    }
+
+    for (FBetOutcomeOption& Option : Event.OutcomeOptions)
+    {
+        const uint16 QuantizedOdds = BettingNetQuantization::QuantizeOdds(Option.DecimalOdds);
+
+        if (Option.DecimalOdds > BettingNetQuantization::MaxOdds)
+        {
+            // Keep the configured odds for settlement; only the replicated value saturates.
+            UE_LOG(LogTemp, Warning, TEXT("SportsBettingComponent: odds %.2f of outcome (%s) in event (%s) exceed the replicated maximum %.2f"),
+                Option.DecimalOdds, *Option.OutcomeId.ToString(), *Event.EventId.ToString(), BettingNetQuantization::MaxOdds);
+        }
+        else
+        {
+            // Settle with exactly the odds the clients are shown.
+            Option.DecimalOdds = BettingNetQuantization::DequantizeOdds(QuantizedOdds);
+        }
+
+        FSportsOddsNetItem* Item = ReplicatedOdds.Items.FindByPredicate(
+            [&Event, &Option](const FSportsOddsNetItem& Candidate)
+            {
+                return Candidate.EventId == Event.EventId && Candidate.OutcomeId == Option.OutcomeId;
+            });
+
+        if (!Item)
+        {
+            Item = &ReplicatedOdds.Items.AddDefaulted_GetRef();
+            Item->EventId = Event.EventId;
+            Item->OutcomeId = Option.OutcomeId;
+        }
+        else if (Item->QuantizedOdds == QuantizedOdds)
+        {
+            continue;
+        }
+
+        Item->QuantizedOdds = QuantizedOdds;
+
+        ReplicatedOdds.MarkItemDirty(*Item);
+    }
+}
+
+void USportsBettingComponent::ApplyReplicatedItem(const FSportsOddsNetItem& Item)
+{
+    FSportsEventConfig* Event = FindEventMutable(Item.EventId);
+    if (!Event)
+    {
+        Event = &Events.AddDefaulted_GetRef();
+        Event->EventId = Item.EventId;
+    }
+
+    FBetOutcomeOption* Option = FindOutcomeMutable(*Event, Item.OutcomeId);
+    if (!Option)
+    {
+        Option = &Event->OutcomeOptions.AddDefaulted_GetRef();
+        Option->OutcomeId = Item.OutcomeId;
+    }
+
+    Option->DecimalOdds = BettingNetQuantization::DequantizeOdds(Item.QuantizedOdds);
+
+    bHasReceivedServerState = true;
+
+    OnOddsReplicated.Broadcast(Item.EventId, Item.OutcomeId);
 }
 
 const FSportsEventConfig* USportsBettingComponent::FindEvent(FName EventId) const
@@ -57,61 +182,29 @@ const FBetOutcomeOption* USportsBettingComponent::FindOutcome(const FSportsEvent
     return nullptr;
 }
 
-float USportsBettingComponent::GetTotalTrueProbabilityWeight(const FSportsEventConfig& Event) const
+FBetOutcomeOption* USportsBettingComponent::FindOutcomeMutable(FSportsEventConfig& Event, FName OutcomeId)
 {
-    float Total = 0.0f;
-    for (const FBetOutcomeOption& Option : Event.OutcomeOptions)
+    for (FBetOutcomeOption& Option : Event.OutcomeOptions)
     {
-        if (Option.TrueProbabilityWeight > 0.0f)
+        if (Option.OutcomeId == OutcomeId)
         {
-            Total += Option.TrueProbabilityWeight;
+            return &Option;
         }
     }
-    return Total;
+    return nullptr;
 }
 
-const FBetOutcomeOption* USportsBettingComponent::SimulateTrueOutcome(const FSportsEventConfig& Event) const
+float USportsBettingComponent::GetTotalTrueProbabilityWeight(const FSportsEventConfig& Event) const
 {
-    const float TotalWeight = GetTotalTrueProbabilityWeight(Event);
-    if (TotalWeight <= 0.0f || Event.OutcomeOptions.Num() == 0)
-    {
-        return nullptr;
-    }
-
-    const float RandomValue = FMath::FRandRange(0.0f, TotalWeight);
-    float Accumulated = 0.0f;
-
-    const FBetOutcomeOption* Selected = nullptr;
-
+    float Total = 0.0f;
     for (const FBetOutcomeOption& Option : Event.OutcomeOptions)
     {
-        if (Option.TrueProbabilityWeight <= 0.0f)
-        {
-            continue;
-        }
-
-        Accumulated += Option.TrueProbabilityWeight;
-
-        if (RandomValue <= Accumulated)
-        {
-            Selected = &Option;
-            break;
-        }
-    }
-
-    if (!Selected)
-    {
-        for (int32 i = Event.OutcomeOptions.Num() - 1; i >= 0; --i)
+        if (Option.TrueProbabilityWeight > 0.0f)
         {
-            if (Event.OutcomeOptions[i].TrueProbabilityWeight > 0.0f)
-            {
-                Selected = &Event.OutcomeOptions[i];
-                break;
-            }
+            Total += Option.TrueProbabilityWeight;
         }
     }
-
-    return Selected;
+    return Total;
 }
 
 float USportsBettingComponent::SimulateEventAndSettleBet(
@@ -122,63 +215,103 @@ float USportsBettingComponent::SimulateEventAndSettleBet(
     bool& bOutPlayerWon
 )
 {
-    OutWinningOutcomeId = NAME_None;
-    bOutPlayerWon = false;
+    float NetWin = 0.0f;
 
-    if (Stake <= 0.0f)
+    SettleBetsBatch(
+        EventId,
+        MakeArrayView(&ChosenOutcomeId, 1),
+        MakeArrayView(&Stake, 1),
+        MakeArrayView(&OutWinningOutcomeId, 1),
+        MakeArrayView(&bOutPlayerWon, 1),
+        MakeArrayView(&NetWin, 1));
+
+    return NetWin;
+}
+
+void USportsBettingComponent::SettleBetsBatch(
+    FName EventId,
+    TConstArrayView<FName> ChosenOutcomeIds,
+    TConstArrayView<float> Stakes,
+    TArrayView<FName> OutWinningOutcomeIds,
+    TArrayView<bool> OutPlayerWon,
+    TArrayView<float> OutNetWins
+)
+{
+    const int32 NumBets = Stakes.Num();
+    check(ChosenOutcomeIds.Num() == NumBets && OutWinningOutcomeIds.Num() == NumBets
+        && OutPlayerWon.Num() == NumBets && OutNetWins.Num() == NumBets);
+
+    for (int32 i = 0; i < NumBets; ++i)
     {
-        Stake = DefaultStake;
+        OutWinningOutcomeIds[i] = NAME_None;
+        OutPlayerWon[i] = false;
+        OutNetWins[i] = 0.0f;
+    }
+
+    if (!HasBettingAuthority())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SportsBettingComponent: bets can only be settled by the server (%s)"),
+            *EventId.ToString());
+        return;
     }
 
     const FSportsEventConfig* Event = FindEvent(EventId);
     if (!Event)
     {
-        UE_LOG(LogTemp, Warning, TEXT("SportsBettingComponent: not found event (%s) on %s"),
-            *EventId.ToString(), *GetOwner()->GetName());
-        return 0.0f;
+        UE_LOG(LogTemp, Warning, TEXT("SportsBettingComponent: not found event (%s) on %s (%d bets skipped)"),
+            *EventId.ToString(), *GetOwner()->GetName(), NumBets);
+        return;
     }
 
-    const float TotalWeight = GetTotalTrueProbabilityWeight(*Event);
-    if (TotalWeight <= 0.0f || Event->OutcomeOptions.Num() == 0)
+    TArray<float, TInlineAllocator<16>> CumulativeWeights;
+    TArray<const FBetOutcomeOption*, TInlineAllocator<16>> WeightedOptions;
+    float TotalWeight = 0.0f;
+
+    for (const FBetOutcomeOption& Option : Event->OutcomeOptions)
     {
-        UE_LOG(LogTemp, Warning, TEXT("SportsBettingComponent: propability calculation failed for event (%s)"),
-            *EventId.ToString());
-        return 0.0f;
+        if (Option.TrueProbabilityWeight > 0.0f)
+        {
+            TotalWeight += Option.TrueProbabilityWeight;
+            CumulativeWeights.Add(TotalWeight);
+            WeightedOptions.Add(&Option);
+        }
     }
 
-    const FBetOutcomeOption* WinningOption = SimulateTrueOutcome(*Event);
-    if (!WinningOption)
+    if (WeightedOptions.Num() == 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("SportsBettingComponent: couldn't roll outcome for event (%s)"),
+        UE_LOG(LogTemp, Warning, TEXT("SportsBettingComponent: propability calculation failed for event (%s)"),
             *EventId.ToString());
-        return 0.0f;
+        return;
     }
 
-    OutWinningOutcomeId = WinningOption->OutcomeId;
+    FPayoutHistogram* Histogram = FPayoutStatsRegistry::IsEnabled() ? &StatsBinding.GetHistogram(this) : nullptr;
 
-    const FBetOutcomeOption* PlayerOption = FindOutcome(*Event, ChosenOutcomeId);
-    if (!PlayerOption)
+    for (int32 i = 0; i < NumBets; ++i)
     {
-        UE_LOG(LogTemp, Warning, TEXT("SportsBettingComponent: OutcomeId (%s) doesn't exist in event (%s)"),
-            *ChosenOutcomeId.ToString(), *EventId.ToString());
-        // Zakad niepoprawny  zwracamy 0.
-        return 0.0f;
-    }
+        const float Stake = Stakes[i] > 0.0f ? Stakes[i] : DefaultStake;
 
-    bOutPlayerWon = (ChosenOutcomeId == OutWinningOutcomeId);
+        // Invalid bets are not rolled, so their winning outcome stays NAME_None.
+        const FBetOutcomeOption* PlayerOption = FindOutcome(*Event, ChosenOutcomeIds[i]);
+        if (!PlayerOption)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("SportsBettingComponent: OutcomeId (%s) doesn't exist in event (%s)"),
+                *ChosenOutcomeIds[i].ToString(), *EventId.ToString());
+            continue;
+        }
 
-    float NetWin = 0.0f;
+        const float RandomValue = FMath::FRandRange(0.0f, TotalWeight);
+        const int32 Slot = FMath::Min(Algo::LowerBound(CumulativeWeights, RandomValue), WeightedOptions.Num() - 1);
+        OutWinningOutcomeIds[i] = WeightedOptions[Slot]->OutcomeId;
 
-    if (bOutPlayerWon)
-    {
-        NetWin = Stake * (PlayerOption->DecimalOdds - 1.0f);
-    }
-    else
-    {
-        NetWin = -Stake;
-    }
+        OutPlayerWon[i] = (ChosenOutcomeIds[i] == OutWinningOutcomeIds[i]);
+        OutNetWins[i] = OutPlayerWon[i] ? Stake * (PlayerOption->DecimalOdds - 1.0f) : -Stake;
 
-    return NetWin;
+        if (Histogram)
+        {
+            const float pTrue = FMath::Max(0.0f, PlayerOption->TrueProbabilityWeight) / TotalWeight;
+            Histogram->Record(Stake, OutNetWins[i], Stake * pTrue * PlayerOption->DecimalOdds);
+        }
+    }
 }
 
 bool USportsBettingComponent::ComputeBetExpectedValue(
@@ -230,6 +363,11 @@ bool USportsBettingComponent::ComputeBetExpectedValue(
 
 void USportsBettingComponent::RecalculateOddsInternal(FSportsEventConfig& Event)
 {
+    if (!HasBettingAuthority())
+    {
+        return;
+    }
+
     const float TotalWeight = GetTotalTrueProbabilityWeight(Event);
     if (TotalWeight <= 0.0f)
     {
@@ -252,8 +390,11 @@ void USportsBettingComponent::RecalculateOddsInternal(FSportsEventConfig& Event)
 
         const float FairOdds = 1.0f / pTrue;
 
-        Option.DecimalOdds = FairOdds * Factor;
+        // Long shots are capped at the largest odds that can be replicated.
+        Option.DecimalOdds = FMath::Min(FairOdds * Factor, BettingNetQuantization::MaxOdds);
     }
+
+    SyncReplicatedOdds(Event);
 }
 
 void USportsBettingComponent::RecalculateDecimalOddsForEvent(FName EventId)
@@ -276,3 +417,8 @@ void USportsBettingComponent::RecalculateDecimalOddsForAllEvents()
         RecalculateOddsInternal(Event);
     }
 }
+
+FPayoutStatsSnapshot USportsBettingComponent::GetPayoutStats() const
+{
+    return StatsBinding.Snapshot(this);
+}
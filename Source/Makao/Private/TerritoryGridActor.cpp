@@ -0,0 +1,403 @@
+// TerritoryGridActor.cpp
+
+#include "TerritoryGridActor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "Net/UnrealNetwork.h"
+
+namespace TerritoryGrid
+{
+    constexpr int32 NumBetColors = static_cast<int32>(EBetColor::Purple) + 1;
+    constexpr int32 NumCustomDataFloats = 3;
+}
+
+void FTerritoryCellChunk::PostReplicatedAdd(const FTerritoryCellChunkArray& InArraySerializer)
+{
+    if (InArraySerializer.OwnerActor)
+    {
+        InArraySerializer.OwnerActor->ApplyReplicatedChunk(*this);
+    }
+}
+
+void FTerritoryCellChunk::PostReplicatedChange(const FTerritoryCellChunkArray& InArraySerializer)
+{
+    if (InArraySerializer.OwnerActor)
+    {
+        InArraySerializer.OwnerActor->ApplyReplicatedChunk(*this);
+    }
+}
+
+ATerritoryGridActor::ATerritoryGridActor()
+{
+    PrimaryActorTick.bCanEverTick = false;
+    bReplicates = true;
+
+    CellInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("CellInstances"));
+    CellInstances->NumCustomDataFloats = TerritoryGrid::NumCustomDataFloats;
+    RootComponent = CellInstances;
+
+    Palette.Add(EBetColor::Blue, FLinearColor(0.05f, 0.2f, 1.0f));
+    Palette.Add(EBetColor::Orange, FLinearColor(1.0f, 0.4f, 0.0f));
+    Palette.Add(EBetColor::Green, FLinearColor(0.1f, 0.8f, 0.1f));
+    Palette.Add(EBetColor::Purple, FLinearColor(0.5f, 0.1f, 0.8f));
+}
+
+void ATerritoryGridActor::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    CellChunks.OwnerActor = this;
+}
+
+void ATerritoryGridActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(ATerritoryGridActor, CellChunks);
+}
+
+void ATerritoryGridActor::OnConstruction(const FTransform& Transform)
+{
+    Super::OnConstruction(Transform);
+
+    BuildInstances();
+    RebuildCellState();
+}
+
+void ATerritoryGridActor::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (CellInstances->GetInstanceCount() != GetNumCells())
+    {
+        BuildInstances();
+    }
+
+    // Level-placed grids load with their saved instances but none of the transient cell state.
+    RebuildCellState();
+
+    AActor* SourceActor = BettingActor ? BettingActor.Get() : this;
+    BettingComponent = SourceActor->FindComponentByClass<UColorTerritoryBettingComponent>();
+
+    if (!BettingComponent)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TerritoryGridActor: no ColorTerritoryBettingComponent found on %s"),
+            *SourceActor->GetName());
+    }
+
+    if (HasAuthority())
+    {
+        InitReplicatedChunks();
+        FlushPendingChanges();
+    }
+}
+
+void ATerritoryGridActor::InitReplicatedChunks()
+{
+    const int32 NumCells = CellColors.Num();
+    const int32 NumChunks = FMath::DivideAndRoundUp(NumCells, CellsPerChunk);
+
+    CellChunks.Items.Reset(NumChunks);
+
+    for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+    {
+        FTerritoryCellChunk& Chunk = CellChunks.Items.AddDefaulted_GetRef();
+        Chunk.FirstCell = ChunkIndex * CellsPerChunk;
+        Chunk.Colors.Append(CellColors.GetData() + Chunk.FirstCell, FMath::Min(CellsPerChunk, NumCells - Chunk.FirstCell));
+
+        CellChunks.MarkItemDirty(Chunk);
+    }
+
+    DirtyChunks.Init(false, NumChunks);
+}
+
+int32 ATerritoryGridActor::GetNumCells() const
+{
+    return FMath::Max(1, GridSizeX) * FMath::Max(1, GridSizeY);
+}
+
+void ATerritoryGridActor::BuildInstances()
+{
+    const int32 NumCells = GetNumCells();
+    const int32 SizeX = FMath::Max(1, GridSizeX);
+
+    CellInstances->ClearInstances();
+    CellInstances->NumCustomDataFloats = TerritoryGrid::NumCustomDataFloats;
+
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(NumCells);
+
+    for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+    {
+        const int32 X = CellIndex % SizeX;
+        const int32 Y = CellIndex / SizeX;
+        Transforms.Emplace(FVector(X * CellSize, Y * CellSize, 0.0f));
+    }
+
+    CellInstances->AddInstances(Transforms, false);
+}
+
+// Sizes the cell arrays to the grid (keeping colours already received from the server),
+// recounts the colours and pushes every cell to the instance custom data.
+void ATerritoryGridActor::RebuildCellState()
+{
+    const int32 NumCells = GetNumCells();
+
+    if (CellColors.Num() != NumCells)
+    {
+        CellColors.Init(NeutralCell, NumCells);
+    }
+
+    AppliedCellColors.Init(NeutralCell, NumCells);
+    ColorCounts.Init(0, TerritoryGrid::NumBetColors);
+
+    for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+    {
+        const uint8 Value = CellColors[CellIndex];
+        if (ColorCounts.IsValidIndex(Value))
+        {
+            ColorCounts[Value]++;
+        }
+
+        ApplyCellCustomData(CellIndex, Value);
+    }
+
+    CellInstances->MarkRenderStateDirty();
+}
+
+FLinearColor ATerritoryGridActor::GetDisplayColor(uint8 Value) const
+{
+    if (Value == NeutralCell)
+    {
+        return NeutralColor;
+    }
+
+    const FLinearColor* Color = Palette.Find(static_cast<EBetColor>(Value));
+    return Color ? *Color : NeutralColor;
+}
+
+void ATerritoryGridActor::ApplyCellCustomData(int32 CellIndex, uint8 Value)
+{
+    const FLinearColor Color = GetDisplayColor(Value);
+    const float CustomData[TerritoryGrid::NumCustomDataFloats] = { Color.R, Color.G, Color.B };
+
+    CellInstances->SetCustomData(CellIndex, CustomData, false);
+    AppliedCellColors[CellIndex] = Value;
+}
+
+void ATerritoryGridActor::InternalSetCell(int32 CellIndex, uint8 NewValue)
+{
+    if (!HasAuthority() || !CellColors.IsValidIndex(CellIndex))
+    {
+        return;
+    }
+
+    const uint8 OldValue = CellColors[CellIndex];
+    if (OldValue == NewValue)
+    {
+        return;
+    }
+
+    if (OldValue != NeutralCell)
+    {
+        ColorCounts[OldValue]--;
+    }
+    if (NewValue != NeutralCell)
+    {
+        ColorCounts[NewValue]++;
+    }
+
+    CellColors[CellIndex] = NewValue;
+    ApplyCellCustomData(CellIndex, NewValue);
+
+    const int32 ChunkIndex = CellIndex / CellsPerChunk;
+    if (DirtyChunks.IsValidIndex(ChunkIndex))
+    {
+        DirtyChunks[ChunkIndex] = true;
+    }
+
+    ScheduleFlush();
+}
+
+void ATerritoryGridActor::SetCellColor(int32 CellIndex, EBetColor Color)
+{
+    InternalSetCell(CellIndex, static_cast<uint8>(Color));
+}
+
+void ATerritoryGridActor::ClearCell(int32 CellIndex)
+{
+    InternalSetCell(CellIndex, NeutralCell);
+}
+
+void ATerritoryGridActor::ClearAllCells()
+{
+    if (!HasAuthority())
+    {
+        return;
+    }
+
+    for (int32 CellIndex = 0; CellIndex < CellColors.Num(); ++CellIndex)
+    {
+        InternalSetCell(CellIndex, NeutralCell);
+    }
+}
+
+// Many cells usually change in the same frame (e.g. a burst of bullets), so instance render data
+// and betting counts are pushed once at the start of the next frame instead of per cell.
+void ATerritoryGridActor::ScheduleFlush()
+{
+    UWorld* World = GetWorld();
+    if (!World || !World->IsGameWorld())
+    {
+        FlushPendingChanges();
+        return;
+    }
+
+    if (!bFlushScheduled)
+    {
+        bFlushScheduled = true;
+        World->GetTimerManager().SetTimerForNextTick(this, &ATerritoryGridActor::FlushPendingChanges);
+    }
+}
+
+void ATerritoryGridActor::FlushPendingChanges()
+{
+    bFlushScheduled = false;
+
+    CellInstances->MarkRenderStateDirty();
+
+    if (!HasAuthority())
+    {
+        return;
+    }
+
+    for (TConstSetBitIterator<> It(DirtyChunks); It; ++It)
+    {
+        FTerritoryCellChunk& Chunk = CellChunks.Items[It.GetIndex()];
+        FMemory::Memcpy(Chunk.Colors.GetData(), CellColors.GetData() + Chunk.FirstCell, Chunk.Colors.Num());
+
+        CellChunks.MarkItemDirty(Chunk);
+    }
+
+    DirtyChunks.Init(false, DirtyChunks.Num());
+
+    if (BettingComponent)
+    {
+        BettingComponent->SetAllBlockCounts(
+            ColorCounts[static_cast<int32>(EBetColor::Blue)],
+            ColorCounts[static_cast<int32>(EBetColor::Orange)],
+            ColorCounts[static_cast<int32>(EBetColor::Green)],
+            ColorCounts[static_cast<int32>(EBetColor::Purple)]);
+    }
+}
+
+void ATerritoryGridActor::ApplyReplicatedChunk(const FTerritoryCellChunk& Chunk)
+{
+    const int32 NumCells = GetNumCells();
+    const int32 EndCell = Chunk.FirstCell + Chunk.Colors.Num();
+
+    if (Chunk.FirstCell < 0 || EndCell > NumCells)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TerritoryGridActor: replicated cells %d-%d are outside the local grid (%d) on %s"),
+            Chunk.FirstCell, EndCell - 1, NumCells, *GetName());
+        return;
+    }
+
+    if (CellColors.Num() != NumCells)
+    {
+        CellColors.Init(NeutralCell, NumCells);
+    }
+
+    FMemory::Memcpy(CellColors.GetData() + Chunk.FirstCell, Chunk.Colors.GetData(), Chunk.Colors.Num());
+
+    // Arrived before the cell state was built; RebuildCellState applies it then.
+    if (AppliedCellColors.Num() != NumCells)
+    {
+        return;
+    }
+
+    bool bAnyChanged = false;
+
+    for (int32 CellIndex = Chunk.FirstCell; CellIndex < EndCell; ++CellIndex)
+    {
+        const uint8 OldValue = AppliedCellColors[CellIndex];
+        const uint8 NewValue = CellColors[CellIndex];
+        if (OldValue == NewValue)
+        {
+            continue;
+        }
+
+        if (ColorCounts.IsValidIndex(OldValue))
+        {
+            ColorCounts[OldValue]--;
+        }
+        if (ColorCounts.IsValidIndex(NewValue))
+        {
+            ColorCounts[NewValue]++;
+        }
+
+        ApplyCellCustomData(CellIndex, NewValue);
+        bAnyChanged = true;
+    }
+
+    if (bAnyChanged)
+    {
+        CellInstances->MarkRenderStateDirty();
+    }
+}
+
+int32 ATerritoryGridActor::GetCellIndexAtLocation(const FVector& WorldLocation) const
+{
+    const FVector Local = GetActorTransform().InverseTransformPosition(WorldLocation);
+
+    const int32 X = FMath::FloorToInt(Local.X / CellSize + 0.5f);
+    const int32 Y = FMath::FloorToInt(Local.Y / CellSize + 0.5f);
+
+    if (X < 0 || Y < 0 || X >= GridSizeX || Y >= GridSizeY)
+    {
+        return INDEX_NONE;
+    }
+
+    return Y * GridSizeX + X;
+}
+
+bool ATerritoryGridActor::PaintCellAtLocation(const FVector& WorldLocation, EBetColor Color)
+{
+    const int32 CellIndex = GetCellIndexAtLocation(WorldLocation);
+    if (CellIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    SetCellColor(CellIndex, Color);
+    return true;
+}
+
+bool ATerritoryGridActor::PaintCellFromHit(const FHitResult& Hit, EBetColor Color)
+{
+    if (Hit.GetComponent() == CellInstances && CellColors.IsValidIndex(Hit.Item))
+    {
+        SetCellColor(Hit.Item, Color);
+        return true;
+    }
+
+    return PaintCellAtLocation(Hit.ImpactPoint, Color);
+}
+
+bool ATerritoryGridActor::GetCellColor(int32 CellIndex, EBetColor& OutColor) const
+{
+    if (!CellColors.IsValidIndex(CellIndex) || CellColors[CellIndex] == NeutralCell)
+    {
+        return false;
+    }
+
+    OutColor = static_cast<EBetColor>(CellColors[CellIndex]);
+    return true;
+}
+
+int32 ATerritoryGridActor::GetCellCountForColor(EBetColor Color) const
+{
+    const int32 Index = static_cast<int32>(Color);
+    return ColorCounts.IsValidIndex(Index) ? ColorCounts[Index] : 0;
+}
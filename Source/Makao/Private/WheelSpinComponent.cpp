@@ -0,0 +1,268 @@
+// WheelSpinComponent.cpp
+
+#include "WheelSpinComponent.h"
+#include "RandomGameComponent.h"
+#include "Math/UnrealMathUtility.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
+
+UWheelSpinComponent::UWheelSpinComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+
+    SetIsReplicatedByDefault(true);
+}
+
+void UWheelSpinComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(UWheelSpinComponent, SpinState);
+}
+
+void UWheelSpinComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    AActor* Owner = GetOwner();
+
+    RandomGame = Owner->FindComponentByClass<URandomGameComponent>();
+    if (!RandomGame && Owner->HasAuthority())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WheelSpinComponent: missing RandomGameComponent on %s"),
+            *Owner->GetName());
+    }
+
+    if (!WheelComponent)
+    {
+        USceneComponent* Found = nullptr;
+
+        if (!WheelComponentName.IsNone())
+        {
+            TInlineComponentArray<USceneComponent*> SceneComponents(Owner);
+            for (USceneComponent* Candidate : SceneComponents)
+            {
+                if (Candidate->GetFName() == WheelComponentName)
+                {
+                    Found = Candidate;
+                    break;
+                }
+            }
+        }
+
+        SetWheelComponent(Found ? Found : Owner->GetRootComponent());
+    }
+
+    BeginLocalSpin();
+}
+
+void UWheelSpinComponent::SetWheelComponent(USceneComponent* InWheelComponent)
+{
+    WheelComponent = InWheelComponent;
+
+    if (WheelComponent)
+    {
+        BaseRelativeRotation = WheelComponent->GetRelativeRotation().Quaternion();
+    }
+}
+
+bool UWheelSpinComponent::StartSpin(float Stake)
+{
+    if (!GetOwner()->HasAuthority())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WheelSpinComponent: spins can only be started by the server (%s)"),
+            *GetOwner()->GetName());
+        return false;
+    }
+
+    if (bSpinning || !RandomGame)
+    {
+        return false;
+    }
+
+    FRandomGameOutcome Outcome;
+    int32 OutcomeIndex = INDEX_NONE;
+    const float NetWin = RandomGame->PlayRoundWithIndex(Stake, Outcome, OutcomeIndex);
+
+    const int32 NumSegments = RandomGame->Outcomes.Num();
+    if (OutcomeIndex == INDEX_NONE || NumSegments <= 0)
+    {
+        return false;
+    }
+
+    const float SegmentSize = 360.0f / static_cast<float>(NumSegments);
+    const float Jitter = FMath::FRandRange(-0.5f, 0.5f) * StopJitter;
+    const float SegmentCenter = SegmentAngleOffset + (static_cast<float>(OutcomeIndex) + 0.5f + Jitter) * SegmentSize;
+
+    // Rotating the wheel by A brings its local angle -A under the pointer.
+    const float StartAngle = FMath::Fmod(GetWheelAngle(), 360.0f);
+    float ToTarget = FMath::Fmod(-SegmentCenter - StartAngle, 360.0f);
+    if (ToTarget < 0.0f)
+    {
+        ToTarget += 360.0f;
+    }
+
+    SpinState.SpinCount++;
+    SpinState.OutcomeIndex = OutcomeIndex;
+    SpinState.NetWin = NetWin;
+    SpinState.StartServerTime = GetSyncedTime();
+    SpinState.Duration = SpinDuration;
+    SpinState.StartAngle = StartAngle;
+    SpinState.DeltaAngle = static_cast<float>(FullTurns) * 360.0f + ToTarget;
+
+    BeginLocalSpin();
+    return true;
+}
+
+void UWheelSpinComponent::OnRep_SpinState()
+{
+    // Before BeginPlay the wheel component isn't resolved yet; BeginPlay picks the state up.
+    if (HasBegunPlay())
+    {
+        BeginLocalSpin();
+    }
+}
+
+void UWheelSpinComponent::BeginLocalSpin()
+{
+    if (SpinState.SpinCount <= LocalSpinCount)
+    {
+        return;
+    }
+
+    LocalSpinCount = SpinState.SpinCount;
+
+    const double RemainingTime = SpinState.Duration - (GetSyncedTime() - SpinState.StartServerTime);
+
+    if (RemainingTime <= 0.0)
+    {
+        // Late joiners and actors becoming relevant again get the spin after it ended:
+        // show where the wheel stopped without announcing an old result.
+        if (!GetOwner()->HasAuthority() && SpinState.Duration > 0.0f)
+        {
+            bSpinning = false;
+            SetComponentTickEnabled(false);
+            ApplyAngle(SpinState.StartAngle + SpinState.DeltaAngle);
+            return;
+        }
+
+        FinishLocalSpin();
+        return;
+    }
+
+    bSpinning = true;
+
+    // Nothing is drawn on a dedicated server, so it only needs to know when the spin ends.
+    if (GetNetMode() == NM_DedicatedServer)
+    {
+        GetWorld()->GetTimerManager().SetTimer(
+            FinishTimerHandle, this, &UWheelSpinComponent::FinishLocalSpin, static_cast<float>(RemainingTime), false);
+        return;
+    }
+
+    SetComponentTickEnabled(true);
+}
+
+void UWheelSpinComponent::FinishLocalSpin()
+{
+    bSpinning = false;
+    SetComponentTickEnabled(false);
+
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(FinishTimerHandle);
+    }
+
+    ApplyAngle(SpinState.StartAngle + SpinState.DeltaAngle);
+
+    FName OutcomeId = NAME_None;
+    if (RandomGame && RandomGame->Outcomes.IsValidIndex(SpinState.OutcomeIndex))
+    {
+        OutcomeId = RandomGame->Outcomes[SpinState.OutcomeIndex].OutcomeId;
+    }
+
+    OnSpinFinished.Broadcast(SpinState.OutcomeIndex, OutcomeId, SpinState.NetWin);
+}
+
+void UWheelSpinComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    const double Now = GetSyncedTime();
+
+    if (Now - SpinState.StartServerTime >= SpinState.Duration)
+    {
+        FinishLocalSpin();
+        return;
+    }
+
+    if (GetOwner()->WasRecentlyRendered(0.2f))
+    {
+        ApplyAngle(EvaluateAngle(Now));
+    }
+}
+
+double UWheelSpinComponent::GetSyncedTime() const
+{
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return 0.0;
+    }
+
+    if (const AGameStateBase* GameState = World->GetGameState())
+    {
+        return GameState->GetServerWorldTimeSeconds();
+    }
+
+    return World->GetTimeSeconds();
+}
+
+float UWheelSpinComponent::EvaluateAngle(double Time) const
+{
+    if (SpinState.Duration <= 0.0f)
+    {
+        return SpinState.StartAngle + SpinState.DeltaAngle;
+    }
+
+    const float Alpha = FMath::Clamp(static_cast<float>((Time - SpinState.StartServerTime) / SpinState.Duration), 0.0f, 1.0f);
+    const float Remaining = 1.0f - Alpha;
+
+    return SpinState.StartAngle + SpinState.DeltaAngle * (1.0f - Remaining * Remaining);
+}
+
+void UWheelSpinComponent::ApplyAngle(float Angle)
+{
+    if (!WheelComponent)
+    {
+        return;
+    }
+
+    const FQuat SpinRotation(LocalRotationAxis.GetSafeNormal(), FMath::DegreesToRadians(FMath::Fmod(Angle, 360.0f)));
+    WheelComponent->SetRelativeRotation(BaseRelativeRotation * SpinRotation);
+}
+
+bool UWheelSpinComponent::IsSpinning() const
+{
+    return bSpinning;
+}
+
+float UWheelSpinComponent::GetWheelAngle() const
+{
+    if (bSpinning)
+    {
+        return EvaluateAngle(GetSyncedTime());
+    }
+
+    return SpinState.StartAngle + SpinState.DeltaAngle;
+}
+
+FWheelSpinState UWheelSpinComponent::GetSpinState() const
+{
+    return SpinState;
+}
@@ -0,0 +1,36 @@
+// BettingNetQuantization.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Fixed-point encodings used when replicating betting state.
+// Odds are sent in 1/100 steps (up to MaxOdds), shares in 1/65535 steps.
+namespace BettingNetQuantization
+{
+    constexpr float OddsScale = 100.0f;
+    constexpr float ShareScale = 65535.0f;
+
+    // Largest odds the encoding can carry; anything above is clamped on the wire.
+    constexpr float MaxOdds = MAX_uint16 / OddsScale;
+
+    FORCEINLINE uint16 QuantizeOdds(float Odds)
+    {
+        return static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Odds * OddsScale), 0, MAX_uint16));
+    }
+
+    FORCEINLINE float DequantizeOdds(uint16 QuantizedOdds)
+    {
+        return static_cast<float>(QuantizedOdds) / OddsScale;
+    }
+
+    FORCEINLINE uint16 QuantizeShare(float Share)
+    {
+        return static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Share * ShareScale), 0, MAX_uint16));
+    }
+
+    FORCEINLINE float DequantizeShare(uint16 QuantizedShare)
+    {
+        return static_cast<float>(QuantizedShare) / ShareScale;
+    }
+}
@@ -0,0 +1,145 @@
+// BettingRoundSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ColorTerritoryBettingComponent.h"
+#include "BettingRoundSubsystem.generated.h"
+
+class URandomGameComponent;
+class USportsBettingComponent;
+class UBettingRoundSubsystem;
+
+UENUM(BlueprintType)
+enum class EWagerKind : uint8
+{
+    RandomRound     UMETA(DisplayName = "Random Round"),
+    SportsBet       UMETA(DisplayName = "Sports Bet"),
+    TerritoryBet    UMETA(DisplayName = "Territory Bet")
+};
+
+USTRUCT(BlueprintType)
+struct FWagerResult
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY(BlueprintReadOnly, Category = "BettingRound")
+    int32 TicketId = INDEX_NONE;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BettingRound")
+    EWagerKind Kind = EWagerKind::RandomRound;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BettingRound")
+    TObjectPtr<UActorComponent> Component = nullptr;
+
+    // Stakes <= 0 are replaced with the component's DefaultStake, as when settling.
+    UPROPERTY(BlueprintReadOnly, Category = "BettingRound")
+    float Stake = 0.0f;
+
+    // False when the wager couldn't be settled (component destroyed, resolved on a client,
+    // unknown event or outcome, nothing to roll against). The fields below are then left at their defaults.
+    UPROPERTY(BlueprintReadOnly, Category = "BettingRound")
+    bool bResolved = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BettingRound")
+    float NetWin = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BettingRound")
+    bool bPlayerWon = false;
+
+    // Random rounds: index into URandomGameComponent::Outcomes.
+    UPROPERTY(BlueprintReadOnly, Category = "BettingRound")
+    int32 OutcomeIndex = INDEX_NONE;
+
+    // Random rounds: chosen OutcomeId. Sports bets: winning OutcomeId.
+    UPROPERTY(BlueprintReadOnly, Category = "BettingRound")
+    FName OutcomeId = NAME_None;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BettingRound")
+    EBetColor WinningColor = EBetColor::Blue;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWagersResolved, const TArray<FWagerResult>&, Results);
+
+struct FBettingRoundTickFunction : public FTickFunction
+{
+    UBettingRoundSubsystem* Target = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+
+    virtual FString DiagnosticMessage() override;
+
+    virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+// Collects wagers queued during the frame and resolves them together in TG_PostUpdateWork.
+// Wagers on the same component (and sports event) share one lookup and one weight table,
+// and all results of the frame are delivered in a single OnWagersResolved broadcast.
+UCLASS()
+class MAKAO_API UBettingRoundSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY(BlueprintAssignable, Category = "BettingRound")
+    FOnWagersResolved OnWagersResolved;
+
+    UFUNCTION(BlueprintCallable, Category = "BettingRound")
+    int32 QueueRandomRound(URandomGameComponent* Game, float Stake);
+
+    UFUNCTION(BlueprintCallable, Category = "BettingRound")
+    int32 QueueSportsBet(USportsBettingComponent* Sports, FName EventId, FName ChosenOutcomeId, float Stake);
+
+    UFUNCTION(BlueprintCallable, Category = "BettingRound")
+    int32 QueueTerritoryBet(UColorTerritoryBettingComponent* Territory, EBetColor Color, float Stake);
+
+    UFUNCTION(BlueprintPure, Category = "BettingRound")
+    int32 GetNumPendingWagers() const;
+
+    // Resolves everything queued so far. Called automatically once per frame.
+    void ResolvePendingWagers();
+
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    virtual void Deinitialize() override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FPendingWager
+    {
+        int32 TicketId = INDEX_NONE;
+        EWagerKind Kind = EWagerKind::RandomRound;
+        TWeakObjectPtr<UActorComponent> Component;
+        FName EventId = NAME_None;
+        FName ChosenOutcomeId = NAME_None;
+        EBetColor Color = EBetColor::Blue;
+        float Stake = 0.0f;
+    };
+
+    FBettingRoundTickFunction ResolveTickFunction;
+
+    TArray<FPendingWager> PendingWagers;
+
+    TArray<FPendingWager> ResolvingWagers;
+
+    // Kept between frames so resolving doesn't reallocate.
+    UPROPERTY(Transient)
+    TArray<FWagerResult> ResolvedResults;
+
+    int32 NextTicketId = 0;
+
+    int32 QueueWager(FPendingWager&& Wager);
+
+    void ResolveRandomGroup(TConstArrayView<int32> Group);
+
+    void ResolveSportsGroup(TConstArrayView<int32> Group);
+
+    void ResolveTerritoryGroup(TConstArrayView<int32> Group);
+};
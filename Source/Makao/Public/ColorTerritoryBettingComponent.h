@@ -4,8 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "PayoutStats.h"
 #include "ColorTerritoryBettingComponent.generated.h"
 
+class UColorTerritoryBettingComponent;
+struct FColorBetNetArray;
+
 UENUM(BlueprintType)
 enum class EBetColor : uint8
 {
@@ -32,6 +37,61 @@ public:
     float DecimalOdds = 0.0f;
 };
 
+// Replicated, quantized view of a single FColorBetInfo entry.
+USTRUCT()
+struct FColorBetNetItem : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY()
+    EBetColor Color = EBetColor::Blue;
+
+    UPROPERTY()
+    int32 BlockCount = 0;
+
+    UPROPERTY()
+    uint16 QuantizedShare = 0;
+
+    UPROPERTY()
+    uint16 QuantizedOdds = 0;
+
+    void PostReplicatedAdd(const FColorBetNetArray& InArraySerializer);
+
+    void PostReplicatedChange(const FColorBetNetArray& InArraySerializer);
+};
+
+USTRUCT()
+struct FColorBetNetArray : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY()
+    TArray<FColorBetNetItem> Items;
+
+    // Set by the owning component in PostInitProperties; never serialized or replicated.
+    UColorTerritoryBettingComponent* OwnerComponent = nullptr;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FColorBetNetItem, FColorBetNetArray>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FColorBetNetArray> : public TStructOpsTypeTraitsBase2<FColorBetNetArray>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnColorBetInfoReplicated, EBetColor, Color);
+
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class MAKAO_API UColorTerritoryBettingComponent : public UActorComponent
 {
@@ -40,6 +100,10 @@ class MAKAO_API UColorTerritoryBettingComponent : public UActorComponent
 public:
     UColorTerritoryBettingComponent();
 
+    // Used by the settlement functions when a bet comes in with a stake <= 0.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Betting|Config")
+    float DefaultStake = 10.0f;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Betting|Config")
     float BaseOdds = 2.0f;
 
@@ -49,7 +113,8 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Betting|Config")
     float MinOdds = 1.01f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Betting|Config")
+    // Capped at 655.35, the largest odds that can be replicated.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Betting|Config", meta = (ClampMax = "655.35"))
     float MaxOdds = 100.0f;
 
     UFUNCTION(BlueprintCallable, Category = "Betting")
@@ -76,14 +141,63 @@ public:
     UFUNCTION(BlueprintPure, Category = "Betting")
     float GetExpectedValueForColor(EBetColor Color, float Stake) const;
 
+    // Server only. Rolls the winning colour with probability equal to its territory share
+    // and settles a bet on Color at its current DecimalOdds. bOutSettled is false (and
+    // OutWinningColor meaningless) when called on a client or while no colour has territory.
+    UFUNCTION(BlueprintCallable, Category = "Betting")
+    float SimulateAndSettleBet(EBetColor Color, float Stake, EBetColor& OutWinningColor, bool& bOutPlayerWon, bool& bOutSettled);
+
+    // Settles several independent bets against a single snapshot of the shares.
+    // Output views must be the same size as Colors and Stakes. Returns false, leaving
+    // OutWinningColors unwritten, when no bet could be settled.
+    bool SettleBetsBatch(
+        TConstArrayView<EBetColor> Colors,
+        TConstArrayView<float> Stakes,
+        TArrayView<EBetColor> OutWinningColors,
+        TArrayView<bool> OutPlayerWon,
+        TArrayView<float> OutNetWins
+    );
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Betting|Stats")
+    FPayoutStatsBinding StatsBinding;
+
+    UFUNCTION(BlueprintPure, Category = "Betting|Stats")
+    FPayoutStatsSnapshot GetPayoutStats() const;
+
+    // True when this instance owns the betting state (server or standalone).
+    // Clients only ever read the last state received from the server.
+    UFUNCTION(BlueprintPure, Category = "Betting|Network")
+    bool HasBettingAuthority() const;
+
+    UFUNCTION(BlueprintPure, Category = "Betting|Network")
+    bool HasReceivedServerState() const;
+
+    UPROPERTY(BlueprintAssignable, Category = "Betting|Network")
+    FOnColorBetInfoReplicated OnBetInfoReplicated;
+
+    virtual void PostInitProperties() override;
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
     virtual void BeginPlay() override;
 
 private:
+    friend struct FColorBetNetItem;
+
     UPROPERTY(VisibleAnywhere, Category = "Betting")
     TMap<EBetColor, FColorBetInfo> ColorInfo;
 
+    UPROPERTY(Replicated)
+    FColorBetNetArray ReplicatedColorInfo;
+
+    bool bHasReceivedServerState = false;
+
     void InitializeColorInfoIfNeeded();
 
     void InternalSetBlockCount(EBetColor Color, int32 BlockCount);
+
+    void SyncReplicatedColorInfo();
+
+    void ApplyReplicatedItem(const FColorBetNetItem& Item);
 };
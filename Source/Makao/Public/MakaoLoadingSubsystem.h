@@ -0,0 +1,125 @@
+// MakaoLoadingSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "MakaoLoadingSubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FMakaoPreloadBundle
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loading")
+    FName Name = NAME_None;
+
+    // Passed to FStreamableManager as the async load priority; higher loads first.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loading")
+    int32 Priority = FStreamableManager::DefaultAsyncLoadPriority;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loading")
+    TArray<FSoftObjectPath> Assets;
+};
+
+USTRUCT(BlueprintType)
+struct FMakaoLoadPhaseTiming
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY(BlueprintReadOnly, Category = "Loading")
+    FName Phase = NAME_None;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Loading")
+    double StartSeconds = 0.0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Loading")
+    double DurationSeconds = 0.0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMakaoPreloadComplete);
+
+// Preloads the gameplay levels' heavy assets (NS_Fire, pinball/turret props, character animations)
+// in priority bundles while MainMenu is up, keeps them resident through the level transition,
+// and times every load phase (startup, each bundle, map loads, menu -> gameplay transition).
+// Bundles and maps are configured in DefaultGame.ini.
+UCLASS(Config = Game)
+class MAKAO_API UMakaoLoadingSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+
+    // Preloading starts automatically once this map has loaded.
+    UPROPERTY(Config)
+    FString PreloadTriggerMap = TEXT("MainMenu");
+
+    UPROPERTY(Config)
+    TArray<FMakaoPreloadBundle> PreloadBundles;
+
+    UPROPERTY(BlueprintAssignable, Category = "Loading")
+    FOnMakaoPreloadComplete OnPreloadComplete;
+
+    UFUNCTION(BlueprintCallable, Category = "Loading")
+    void StartPreload();
+
+    UFUNCTION(BlueprintPure, Category = "Loading")
+    bool IsPreloadComplete() const;
+
+    UFUNCTION(BlueprintPure, Category = "Loading")
+    float GetPreloadProgress() const;
+
+    // Opens the level as soon as every preload bundle has finished (immediately if they already have).
+    // Ignored while another level is pending; ReleasePreloadedAssets cancels the pending one.
+    UFUNCTION(BlueprintCallable, Category = "Loading")
+    void OpenLevelWhenPreloaded(FName LevelName);
+
+    // Lets the preloaded assets be garbage collected. Cancels a pending OpenLevelWhenPreloaded.
+    UFUNCTION(BlueprintCallable, Category = "Loading")
+    void ReleasePreloadedAssets();
+
+    UFUNCTION(BlueprintPure, Category = "Loading")
+    TArray<FMakaoLoadPhaseTiming> GetLoadPhaseTimings() const;
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    virtual void Deinitialize() override;
+
+private:
+    FStreamableManager StreamableManager;
+
+    TArray<TSharedPtr<FStreamableHandle>> BundleHandles;
+
+    TArray<FMakaoLoadPhaseTiming> PhaseTimings;
+
+    TMap<FName, double> OpenPhases;
+
+    FName PendingLevel = NAME_None;
+
+    int32 NumBundlesInFlight = 0;
+
+    bool bPreloadStarted = false;
+
+    bool bStartupRecorded = false;
+
+    FDelegateHandle PreLoadMapHandle;
+
+    FDelegateHandle PostLoadMapHandle;
+
+    void BeginPhase(FName Phase);
+
+    void EndPhase(FName Phase);
+
+    void HandleBundleLoaded(FName BundleName);
+
+    void HandlePreLoadMap(const FString& MapName);
+
+    void HandlePostLoadMap(UWorld* LoadedWorld);
+
+    void OpenPendingLevel();
+};
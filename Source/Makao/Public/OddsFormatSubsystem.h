@@ -0,0 +1,69 @@
+// OddsFormatSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ColorTerritoryBettingComponent.h"
+#include "SportsBettingComponent.h"
+#include "OddsFormatSubsystem.generated.h"
+
+UENUM(BlueprintType)
+enum class EOddsFormat : uint8
+{
+    Decimal     UMETA(DisplayName = "Decimal"),
+    Fractional  UMETA(DisplayName = "Fractional"),
+    American    UMETA(DisplayName = "American")
+};
+
+// Turns DecimalOdds into display text for the betting UI. Odds are quantized to 1/100
+// (the same grid the server replicates), and every formatted FText is cached per culture,
+// so widgets binding odds every frame reuse one FText instead of formatting a float each time.
+UCLASS()
+class MAKAO_API UOddsFormatSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+
+    UFUNCTION(BlueprintPure, Category = "OddsFormat")
+    FText FormatOdds(float DecimalOdds, EOddsFormat Format);
+
+    UFUNCTION(BlueprintPure, Category = "OddsFormat")
+    FText FormatColorBetOdds(const FColorBetInfo& BetInfo, EOddsFormat Format);
+
+    UFUNCTION(BlueprintPure, Category = "OddsFormat")
+    FText FormatOutcomeOdds(const FBetOutcomeOption& Option, EOddsFormat Format);
+
+    UFUNCTION(BlueprintCallable, Category = "OddsFormat")
+    void ClearCache();
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    virtual void Deinitialize() override;
+
+private:
+    struct FFraction
+    {
+        uint16 Numerator = 0;
+        uint16 Denominator = 1;
+    };
+
+    // Index = quantized odds (hundredths). Covers odds up to MaxFractionTableOdds.
+    static constexpr int32 MaxFractionTableOdds = 10000;
+
+    TArray<FFraction> FractionTable;
+
+    // One cache per language/locale pair, so switching back and forth keeps earlier entries.
+    TMap<FString, TMap<uint32, FText>> CacheByCulture;
+
+    TMap<uint32, FText>* CurrentCache = nullptr;
+
+    FDelegateHandle CultureChangedHandle;
+
+    void BuildFractionTable();
+
+    void HandleCultureChanged();
+
+    FText BuildText(uint16 QuantizedOdds, EOddsFormat Format) const;
+};
@@ -0,0 +1,168 @@
+// PayoutStats.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
+#include "PayoutStats.generated.h"
+
+class UActorComponent;
+
+USTRUCT(BlueprintType)
+struct FPayoutStatsSnapshot
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY(BlueprintReadOnly, Category = "PayoutStats")
+    FName GameId = NAME_None;
+
+    UPROPERTY(BlueprintReadOnly, Category = "PayoutStats")
+    int64 Rounds = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "PayoutStats")
+    double TotalStaked = 0.0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "PayoutStats")
+    double TotalReturned = 0.0;
+
+    // TotalReturned / TotalStaked.
+    UPROPERTY(BlueprintReadOnly, Category = "PayoutStats")
+    double RTP = 0.0;
+
+    // RTP the configured odds/weights predict for the same rounds (ComputeExpectedValue and friends).
+    UPROPERTY(BlueprintReadOnly, Category = "PayoutStats")
+    double ExpectedRTP = 0.0;
+
+    // Fraction of rounds with a positive net win.
+    UPROPERTY(BlueprintReadOnly, Category = "PayoutStats")
+    double HitRate = 0.0;
+
+    // Percentiles of the gross payout (stake + net win) per round.
+    UPROPERTY(BlueprintReadOnly, Category = "PayoutStats")
+    float PayoutP50 = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "PayoutStats")
+    float PayoutP90 = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "PayoutStats")
+    float PayoutP99 = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "PayoutStats")
+    float PayoutMax = 0.0f;
+};
+
+// Log-bucketed (HDR-style) histogram of per-round payouts plus running RTP sums.
+// Recording is wait-free: each thread writes relaxed atomics in its own cache-line aligned shard,
+// and readers merge all shards. Values are stored in 1/100 currency units with ~3% bucket precision.
+class MAKAO_API FPayoutHistogram
+{
+public:
+    static constexpr int32 NumShards = 8;
+    static constexpr int32 SubBucketBits = 5;
+    static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+    static constexpr int32 SubBucketHalf = SubBucketCount / 2;
+    static constexpr int32 MaxShift = 36;
+    static constexpr int32 NumBuckets = SubBucketCount + MaxShift * SubBucketHalf;
+    static constexpr double FixedPointScale = 100.0;
+
+    explicit FPayoutHistogram(FName InGameId);
+
+    void Record(float Stake, float NetWin, float ExpectedReturn);
+
+    void Reset();
+
+    FPayoutStatsSnapshot Snapshot() const;
+
+    FName GetGameId() const { return GameId; }
+
+    static int32 GetBucketIndex(uint64 Value);
+
+    static uint64 GetBucketLowerBound(int32 BucketIndex);
+
+    static uint64 GetBucketUpperBound(int32 BucketIndex);
+
+private:
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+    {
+        std::atomic<uint64> Buckets[NumBuckets];
+        std::atomic<int64> Rounds;
+        std::atomic<int64> Hits;
+        std::atomic<int64> Staked;
+        std::atomic<int64> Returned;
+        std::atomic<int64> ExpectedReturned;
+    };
+
+    FName GameId;
+
+    TUniquePtr<FShard[]> Shards;
+
+    FShard& GetLocalShard();
+};
+
+// Process-wide lookup from game id to its histogram. Lookups take a lock, so callers
+// resolve their histogram once and keep the shared pointer.
+class MAKAO_API FPayoutStatsRegistry
+{
+public:
+    static FPayoutStatsRegistry& Get();
+
+    static bool IsEnabled();
+
+    static FName MakeGameId(const UActorComponent* Component, FName ConfiguredId);
+
+    TSharedRef<FPayoutHistogram, ESPMode::ThreadSafe> FindOrAdd(FName GameId);
+
+    TSharedPtr<FPayoutHistogram, ESPMode::ThreadSafe> Find(FName GameId) const;
+
+    TArray<FPayoutStatsSnapshot> SnapshotAll() const;
+
+    void ResetAll();
+
+private:
+    mutable FRWLock Lock;
+
+    TMap<FName, TSharedRef<FPayoutHistogram, ESPMode::ThreadSafe>> Histograms;
+};
+
+// A game component's link to its histogram in FPayoutStatsRegistry. The histogram is registered
+// by the first recorded round, so reading stats before then doesn't add an empty game.
+USTRUCT(BlueprintType)
+struct MAKAO_API FPayoutStatsBinding
+{
+    GENERATED_BODY()
+
+public:
+
+    // Defaults to "<OwnerClass>.<ComponentName>"; set before the first round.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PayoutStats")
+    FName GameId = NAME_None;
+
+    FPayoutHistogram& GetHistogram(const UActorComponent* Component);
+
+    // Empty snapshot if the component hasn't recorded a round yet.
+    FPayoutStatsSnapshot Snapshot(const UActorComponent* Component) const;
+
+private:
+    mutable TSharedPtr<FPayoutHistogram, ESPMode::ThreadSafe> Histogram;
+};
+
+UCLASS()
+class MAKAO_API UPayoutStatsLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+
+    UFUNCTION(BlueprintCallable, Category = "PayoutStats")
+    static bool GetPayoutStats(FName GameId, FPayoutStatsSnapshot& OutStats);
+
+    UFUNCTION(BlueprintCallable, Category = "PayoutStats")
+    static TArray<FPayoutStatsSnapshot> GetAllPayoutStats();
+
+    UFUNCTION(BlueprintCallable, Category = "PayoutStats")
+    static void ResetAllPayoutStats();
+};
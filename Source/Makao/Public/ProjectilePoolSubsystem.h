@@ -0,0 +1,117 @@
+// ProjectilePoolSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectilePoolSubsystem.generated.h"
+
+USTRUCT()
+struct FProjectilePoolBucket
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY()
+    TArray<TObjectPtr<AActor>> InactiveActors;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPooledProjectileHit, AActor*, Projectile, const FHitResult&, Hit);
+
+// Recycles projectile actors (BP_Bullet) instead of spawning and destroying one per shot.
+// Pooled actors are hidden and have collision and tick disabled while inactive.
+UCLASS(Config = Game)
+class MAKAO_API UProjectilePoolSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY(Config)
+    TSoftClassPtr<AActor> DefaultProjectileClass;
+
+    UPROPERTY(Config)
+    int32 PrewarmCount = 32;
+
+    UPROPERTY(Config)
+    float DefaultLifetime = 3.0f;
+
+    UPROPERTY(Config)
+    TEnumAsByte<ECollisionChannel> BatchedTraceChannel = ECC_WorldDynamic;
+
+    // Fired for projectiles moved by the batched update. Projectiles driven by their own
+    // ProjectileMovementComponent report hits through their Blueprint as before.
+    UPROPERTY(BlueprintAssignable, Category = "ProjectilePool")
+    FOnPooledProjectileHit OnProjectileHit;
+
+    UFUNCTION(BlueprintCallable, Category = "ProjectilePool")
+    void PrewarmPool(TSubclassOf<AActor> ProjectileClass, int32 Count);
+
+    // Takes a projectile from the pool (spawning only if it's empty) and launches it along the transform's forward vector.
+    // With bBatchedMovement the subsystem moves it with a single line trace per frame instead of its movement component,
+    // so hits ignore the projectile's collision shape.
+    UFUNCTION(BlueprintCallable, Category = "ProjectilePool", meta = (AdvancedDisplay = "Lifetime,bBatchedMovement"))
+    AActor* FireProjectile(
+        TSubclassOf<AActor> ProjectileClass,
+        const FTransform& SpawnTransform,
+        float Speed,
+        AActor* Instigator,
+        float Lifetime = -1.0f,
+        bool bBatchedMovement = false
+    );
+
+    // Call instead of DestroyActor when a pooled projectile hits something.
+    UFUNCTION(BlueprintCallable, Category = "ProjectilePool")
+    void ReleaseProjectile(AActor* Projectile);
+
+    UFUNCTION(BlueprintPure, Category = "ProjectilePool")
+    int32 GetNumActiveProjectiles() const;
+
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    virtual void Deinitialize() override;
+
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    UPROPERTY()
+    TMap<TObjectPtr<UClass>, FProjectilePoolBucket> Pools;
+
+    // DefaultProjectileClass once loaded; resolved at world begin play whether or not the pool is prewarmed.
+    UPROPERTY()
+    TObjectPtr<UClass> LoadedDefaultClass;
+
+    // Active projectiles, stored as parallel arrays and compacted with swap-removal.
+    UPROPERTY()
+    TArray<TObjectPtr<AActor>> ActiveActors;
+
+    TArray<FVector> ActivePositions;
+
+    TArray<FVector> ActiveVelocities;
+
+    TArray<float> ActiveLifetimes;
+
+    TArray<bool> ActiveBatched;
+
+    // Bumped on every activation, so a hit collected for one shot can't release the next shot fired from the same actor.
+    TArray<uint32> ActiveSerials;
+
+    uint32 NextActivationSerial = 0;
+
+    UClass* ResolveDefaultProjectileClass();
+
+    AActor* SpawnPooledActor(UClass* ProjectileClass);
+
+    void ActivateActor(AActor* Actor, const FTransform& SpawnTransform, const FVector& Velocity, AActor* Instigator, bool bBatchedMovement);
+
+    void DeactivateActor(AActor* Actor);
+
+    void ReleaseActiveAt(int32 ActiveIndex);
+};
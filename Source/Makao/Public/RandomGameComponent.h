@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "PayoutStats.h"
 #include "RandomGameComponent.generated.h"
 
 USTRUCT(BlueprintType)
@@ -40,9 +41,23 @@ public:
     UFUNCTION(BlueprintCallable, Category = "RandomGame")
     float PlayRound(float Stake, FRandomGameOutcome& OutChosenOutcome);
 
+    // Same as PlayRound, also reporting the index of the chosen entry in Outcomes (INDEX_NONE on failure).
+    UFUNCTION(BlueprintCallable, Category = "RandomGame")
+    float PlayRoundWithIndex(float Stake, FRandomGameOutcome& OutChosenOutcome, int32& OutOutcomeIndex);
+
     UFUNCTION(BlueprintCallable, Category = "RandomGame")
     float ComputeExpectedValue(float Stake) const;
 
+    // Plays one round per stake, building the weight table once for the whole batch.
+    // Output views must be the same size as Stakes.
+    void PlayRoundsBatch(TConstArrayView<float> Stakes, TArrayView<int32> OutOutcomeIndices, TArrayView<float> OutNetWins);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RandomGame|Stats")
+    FPayoutStatsBinding StatsBinding;
+
+    UFUNCTION(BlueprintPure, Category = "RandomGame|Stats")
+    FPayoutStatsSnapshot GetPayoutStats() const;
+
 protected:
     virtual void BeginPlay() override;
 
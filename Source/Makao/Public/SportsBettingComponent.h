@@ -4,8 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "PayoutStats.h"
 #include "SportsBettingComponent.generated.h"
 
+class USportsBettingComponent;
+struct FSportsOddsNetArray;
+
 USTRUCT(BlueprintType)
 struct FBetOutcomeOption
 {
@@ -40,6 +45,58 @@ public:
     float OverroundMargin = 0.0f;
 };
 
+// Replicated, quantized odds of a single outcome of a single event.
+USTRUCT()
+struct FSportsOddsNetItem : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY()
+    FName EventId = NAME_None;
+
+    UPROPERTY()
+    FName OutcomeId = NAME_None;
+
+    UPROPERTY()
+    uint16 QuantizedOdds = 0;
+
+    void PostReplicatedAdd(const FSportsOddsNetArray& InArraySerializer);
+
+    void PostReplicatedChange(const FSportsOddsNetArray& InArraySerializer);
+};
+
+USTRUCT()
+struct FSportsOddsNetArray : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY()
+    TArray<FSportsOddsNetItem> Items;
+
+    // Set by the owning component in PostInitProperties; never serialized or replicated.
+    USportsBettingComponent* OwnerComponent = nullptr;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FSportsOddsNetItem, FSportsOddsNetArray>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FSportsOddsNetArray> : public TStructOpsTypeTraitsBase2<FSportsOddsNetArray>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSportsOddsReplicated, FName, EventId, FName, OutcomeId);
+
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class MAKAO_API USportsBettingComponent : public UActorComponent
 {
@@ -54,6 +111,8 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SportsBetting|Config")
     TArray<FSportsEventConfig> Events;
 
+    // Settles a single bet through SettleBetsBatch. An unknown ChosenOutcomeId isn't rolled,
+    // so OutWinningOutcomeId stays NAME_None and the result is 0.
     UFUNCTION(BlueprintCallable, Category = "SportsBetting")
     float SimulateEventAndSettleBet(
         FName EventId,
@@ -71,25 +130,72 @@ public:
         float& OutEV
     ) const;
 
+    // Settles several independent bets on one event, looking the event up once.
+    // Output views must be the same size as ChosenOutcomeIds and Stakes.
+    // Bets that couldn't be settled get NAME_None as their winning outcome.
+    void SettleBetsBatch(
+        FName EventId,
+        TConstArrayView<FName> ChosenOutcomeIds,
+        TConstArrayView<float> Stakes,
+        TArrayView<FName> OutWinningOutcomeIds,
+        TArrayView<bool> OutPlayerWon,
+        TArrayView<float> OutNetWins
+    );
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SportsBetting|Stats")
+    FPayoutStatsBinding StatsBinding;
+
+    UFUNCTION(BlueprintPure, Category = "SportsBetting|Stats")
+    FPayoutStatsSnapshot GetPayoutStats() const;
+
     UFUNCTION(BlueprintCallable, Category = "SportsBetting")
     void RecalculateDecimalOddsForEvent(FName EventId);
 
     UFUNCTION(BlueprintCallable, Category = "SportsBetting")
     void RecalculateDecimalOddsForAllEvents();
 
+    // Pushes the current DecimalOdds of every event to clients. Only needed after
+    // editing Events directly; the recalculation functions do this themselves.
+    UFUNCTION(BlueprintCallable, Category = "SportsBetting|Network")
+    void RefreshReplicatedOdds();
+
+    UFUNCTION(BlueprintPure, Category = "SportsBetting|Network")
+    bool HasBettingAuthority() const;
+
+    UFUNCTION(BlueprintPure, Category = "SportsBetting|Network")
+    bool HasReceivedServerState() const;
+
+    UPROPERTY(BlueprintAssignable, Category = "SportsBetting|Network")
+    FOnSportsOddsReplicated OnOddsReplicated;
+
+    virtual void PostInitProperties() override;
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
     virtual void BeginPlay() override;
 
 private:
+    friend struct FSportsOddsNetItem;
+
+    UPROPERTY(Replicated)
+    FSportsOddsNetArray ReplicatedOdds;
+
+    bool bHasReceivedServerState = false;
+
+    void SyncReplicatedOdds(FSportsEventConfig& Event);
+
+    void ApplyReplicatedItem(const FSportsOddsNetItem& Item);
+
     const FSportsEventConfig* FindEvent(FName EventId) const;
 
     FSportsEventConfig* FindEventMutable(FName EventId);
 
     const FBetOutcomeOption* FindOutcome(const FSportsEventConfig& Event, FName OutcomeId) const;
 
-    float GetTotalTrueProbabilityWeight(const FSportsEventConfig& Event) const;
+    FBetOutcomeOption* FindOutcomeMutable(FSportsEventConfig& Event, FName OutcomeId);
 
-    const FBetOutcomeOption* SimulateTrueOutcome(const FSportsEventConfig& Event) const;
+    float GetTotalTrueProbabilityWeight(const FSportsEventConfig& Event) const;
 
     void RecalculateOddsInternal(FSportsEventConfig& Event);
 };
@@ -0,0 +1,174 @@
+// TerritoryGridActor.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "ColorTerritoryBettingComponent.h"
+#include "TerritoryGridActor.generated.h"
+
+class ATerritoryGridActor;
+class UInstancedStaticMeshComponent;
+struct FTerritoryCellChunkArray;
+
+// Replicated colours of a fixed-size run of cells, starting at FirstCell.
+USTRUCT()
+struct FTerritoryCellChunk : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY()
+    int32 FirstCell = 0;
+
+    UPROPERTY()
+    TArray<uint8> Colors;
+
+    void PostReplicatedAdd(const FTerritoryCellChunkArray& InArraySerializer);
+
+    void PostReplicatedChange(const FTerritoryCellChunkArray& InArraySerializer);
+};
+
+USTRUCT()
+struct FTerritoryCellChunkArray : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY()
+    TArray<FTerritoryCellChunk> Items;
+
+    // Set by the owning actor in PostInitProperties; never serialized or replicated.
+    ATerritoryGridActor* OwnerActor = nullptr;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FTerritoryCellChunk, FTerritoryCellChunkArray>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FTerritoryCellChunkArray> : public TStructOpsTypeTraitsBase2<FTerritoryCellChunkArray>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+// Renders the whole territory as one instanced mesh instead of one BP_CubeMapElement actor per cell.
+// Cell colour goes to the material through per-instance custom data (R, G, B in slots 0-2).
+// Cells replicate in chunks of CellsPerChunk, so only chunks with changed cells are sent and
+// no replicated array comes near net.MaxRepArraySize, whatever the grid size.
+UCLASS()
+class MAKAO_API ATerritoryGridActor : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    ATerritoryGridActor();
+
+    static constexpr uint8 NeutralCell = MAX_uint8;
+
+    static constexpr int32 CellsPerChunk = 256;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Territory")
+    TObjectPtr<UInstancedStaticMeshComponent> CellInstances;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Territory|Config", meta = (ClampMin = "1"))
+    int32 GridSizeX = 32;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Territory|Config", meta = (ClampMin = "1"))
+    int32 GridSizeY = 32;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Territory|Config", meta = (ClampMin = "1.0"))
+    float CellSize = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Territory|Config")
+    FLinearColor NeutralColor = FLinearColor(0.5f, 0.5f, 0.5f);
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Territory|Config")
+    TMap<EBetColor, FLinearColor> Palette;
+
+    // Actor holding the UColorTerritoryBettingComponent fed by this grid. Defaults to this actor.
+    UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "Territory|Config")
+    TObjectPtr<AActor> BettingActor;
+
+    UFUNCTION(BlueprintCallable, Category = "Territory")
+    void SetCellColor(int32 CellIndex, EBetColor Color);
+
+    UFUNCTION(BlueprintCallable, Category = "Territory")
+    void ClearCell(int32 CellIndex);
+
+    UFUNCTION(BlueprintCallable, Category = "Territory")
+    void ClearAllCells();
+
+    UFUNCTION(BlueprintCallable, Category = "Territory")
+    bool PaintCellAtLocation(const FVector& WorldLocation, EBetColor Color);
+
+    UFUNCTION(BlueprintCallable, Category = "Territory")
+    bool PaintCellFromHit(const FHitResult& Hit, EBetColor Color);
+
+    UFUNCTION(BlueprintPure, Category = "Territory")
+    bool GetCellColor(int32 CellIndex, EBetColor& OutColor) const;
+
+    UFUNCTION(BlueprintPure, Category = "Territory")
+    int32 GetCellIndexAtLocation(const FVector& WorldLocation) const;
+
+    UFUNCTION(BlueprintPure, Category = "Territory")
+    int32 GetCellCountForColor(EBetColor Color) const;
+
+    UFUNCTION(BlueprintPure, Category = "Territory")
+    int32 GetNumCells() const;
+
+    virtual void OnConstruction(const FTransform& Transform) override;
+
+    virtual void PostInitProperties() override;
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+    virtual void BeginPlay() override;
+
+private:
+    UPROPERTY()
+    TObjectPtr<UColorTerritoryBettingComponent> BettingComponent;
+
+    friend struct FTerritoryCellChunk;
+
+    UPROPERTY(Transient, Replicated)
+    FTerritoryCellChunkArray CellChunks;
+
+    TArray<uint8> CellColors;
+
+    // Colours currently pushed to the instance custom data, used to apply only changed cells on clients.
+    TArray<uint8> AppliedCellColors;
+
+    TArray<int32> ColorCounts;
+
+    // Chunks with cells changed since the last flush (server only).
+    TBitArray<> DirtyChunks;
+
+    bool bFlushScheduled = false;
+
+    void InitReplicatedChunks();
+
+    void ApplyReplicatedChunk(const FTerritoryCellChunk& Chunk);
+
+    void BuildInstances();
+
+    void RebuildCellState();
+
+    void InternalSetCell(int32 CellIndex, uint8 NewValue);
+
+    void ApplyCellCustomData(int32 CellIndex, uint8 Value);
+
+    void ScheduleFlush();
+
+    void FlushPendingChanges();
+
+    FLinearColor GetDisplayColor(uint8 Value) const;
+};
@@ -0,0 +1,134 @@
+// WheelSpinComponent.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WheelSpinComponent.generated.h"
+
+class URandomGameComponent;
+class USceneComponent;
+
+USTRUCT(BlueprintType)
+struct FWheelSpinState
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY(BlueprintReadOnly, Category = "WheelSpin")
+    int32 SpinCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WheelSpin")
+    int32 OutcomeIndex = INDEX_NONE;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WheelSpin")
+    float NetWin = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WheelSpin")
+    double StartServerTime = 0.0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WheelSpin")
+    float Duration = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WheelSpin")
+    float StartAngle = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WheelSpin")
+    float DeltaAngle = 0.0f;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnWheelSpinFinished, int32, OutcomeIndex, FName, OutcomeId, float, NetWin);
+
+// Spins BP_WheelOfFortune without physics. The server rolls the result through URandomGameComponent
+// first, then every machine evaluates the same constant-deceleration curve that stops on that segment:
+// Angle(t) = StartAngle + DeltaAngle * (1 - (1 - t / Duration)^2).
+// The component only ticks while a spin is in progress and skips the transform update while the wheel isn't rendered;
+// a dedicated server doesn't tick at all and finishes the spin on a timer.
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class MAKAO_API UWheelSpinComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UWheelSpinComponent();
+
+    // Component rotated by the spin. Defaults to the scene component named WheelComponentName, or the owner's root.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WheelSpin|Config")
+    FName WheelComponentName = NAME_None;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WheelSpin|Config")
+    FVector LocalRotationAxis = FVector::ForwardVector;
+
+    // Angle of the start of segment 0 relative to the pointer, in degrees.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WheelSpin|Config")
+    float SegmentAngleOffset = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WheelSpin|Config", meta = (ClampMin = "0.1"))
+    float SpinDuration = 5.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WheelSpin|Config", meta = (ClampMin = "0"))
+    int32 FullTurns = 4;
+
+    // Fraction of a segment the wheel may stop away from its centre, so stops don't all look identical.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WheelSpin|Config", meta = (ClampMin = "0.0", ClampMax = "0.95"))
+    float StopJitter = 0.6f;
+
+    UPROPERTY(BlueprintAssignable, Category = "WheelSpin")
+    FOnWheelSpinFinished OnSpinFinished;
+
+    // Server only. Rolls the outcome up front and starts the visual spin towards it.
+    UFUNCTION(BlueprintCallable, Category = "WheelSpin")
+    bool StartSpin(float Stake);
+
+    UFUNCTION(BlueprintCallable, Category = "WheelSpin")
+    void SetWheelComponent(USceneComponent* InWheelComponent);
+
+    UFUNCTION(BlueprintPure, Category = "WheelSpin")
+    bool IsSpinning() const;
+
+    UFUNCTION(BlueprintPure, Category = "WheelSpin")
+    float GetWheelAngle() const;
+
+    UFUNCTION(BlueprintPure, Category = "WheelSpin")
+    FWheelSpinState GetSpinState() const;
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+    virtual void BeginPlay() override;
+
+private:
+    UPROPERTY()
+    TObjectPtr<URandomGameComponent> RandomGame;
+
+    UPROPERTY()
+    TObjectPtr<USceneComponent> WheelComponent;
+
+    UPROPERTY(ReplicatedUsing = OnRep_SpinState)
+    FWheelSpinState SpinState;
+
+    FQuat BaseRelativeRotation = FQuat::Identity;
+
+    bool bSpinning = false;
+
+    // SpinCount of the last spin started (or snapped to) on this machine.
+    int32 LocalSpinCount = 0;
+
+    FTimerHandle FinishTimerHandle;
+
+    UFUNCTION()
+    void OnRep_SpinState();
+
+    void BeginLocalSpin();
+
+    void FinishLocalSpin();
+
+    double GetSyncedTime() const;
+
+    float EvaluateAngle(double Time) const;
+
+    void ApplyAngle(float Angle);
+};